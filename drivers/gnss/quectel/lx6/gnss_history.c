@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include "gnss_history.h"
+
+/* Time, latitude, longitude, altitude, speed and bearing */
+#define GNSS_HISTORY_FIELDS          (6)
+/* A 64-bit varint takes at most 10 bytes */
+#define GNSS_HISTORY_VARINT_SIZE_MAX (10)
+#define GNSS_HISTORY_RECORD_SIZE_MAX (GNSS_HISTORY_FIELDS * GNSS_HISTORY_VARINT_SIZE_MAX)
+
+#define GNSS_HISTORY_MS_PER_DAY (86400000ULL)
+
+/*
+ * Number of days between 2000-01-01 and the given date, using the days from
+ * civil algorithm with years starting in March.
+ */
+static int64_t gnss_history_days_since_2000(uint32_t year, uint32_t month, uint32_t day)
+{
+	uint32_t era;
+	uint32_t yoe;
+	uint32_t doy;
+	uint32_t doe;
+
+	year -= (month <= 2) ? 1 : 0;
+	era = year / 400;
+	yoe = year - (era * 400);
+	doy = ((153 * ((month > 2) ? (month - 3) : (month + 9))) + 2) / 5 + day - 1;
+	doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+	/* 730425 is the number of days from 0000-03-01 to 2000-01-01 */
+	return ((int64_t)era * 146097) + doe - 730425;
+}
+
+static uint64_t gnss_history_timestamp_ms(const struct gnss_time *utc)
+{
+	uint64_t ms;
+
+	ms = ((uint64_t)utc->hour * 3600000) + ((uint64_t)utc->minute * 60000) + utc->millisecond;
+
+	/* Date is unknown until a sentence carrying it is received */
+	if ((utc->month == 0) || (utc->month_day == 0)) {
+		return ms;
+	}
+
+	return ms + (gnss_history_days_since_2000(2000 + utc->century_year, utc->month,
+						  utc->month_day) *
+		     GNSS_HISTORY_MS_PER_DAY);
+}
+
+static size_t gnss_history_put_varint(uint8_t *record, int64_t value)
+{
+	/* Zigzag encoding keeps small negative deltas small */
+	uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	size_t size = 0;
+
+	while (zigzag >= 0x80) {
+		record[size++] = (uint8_t)(zigzag | 0x80);
+		zigzag >>= 7;
+	}
+
+	record[size++] = (uint8_t)zigzag;
+	return size;
+}
+
+static uint8_t gnss_history_get_byte(const struct gnss_history *history, uint16_t *pos)
+{
+	uint8_t byte = history->buf[*pos];
+
+	*pos = (*pos + 1 == history->buf_size) ? 0 : *pos + 1;
+	return byte;
+}
+
+static int64_t gnss_history_get_varint(const struct gnss_history *history, uint16_t *pos,
+				       uint16_t *size)
+{
+	uint64_t zigzag = 0;
+	uint8_t shift = 0;
+	uint8_t byte;
+
+	do {
+		byte = gnss_history_get_byte(history, pos);
+		zigzag |= (uint64_t)(byte & 0x7F) << shift;
+		shift += 7;
+		(*size)++;
+	} while (byte & 0x80);
+
+	return (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+}
+
+static size_t gnss_history_encode(uint8_t *record, const struct gnss_history_fix *prev,
+				  const struct gnss_history_fix *fix)
+{
+	size_t size = 0;
+
+	/* Differences are computed modulo 2^64, decoding wraps back to the exact value */
+	size += gnss_history_put_varint(&record[size],
+					(int64_t)(fix->timestamp_ms - prev->timestamp_ms));
+	size += gnss_history_put_varint(&record[size],
+					(int64_t)((uint64_t)fix->latitude - prev->latitude));
+	size += gnss_history_put_varint(&record[size],
+					(int64_t)((uint64_t)fix->longitude - prev->longitude));
+	size += gnss_history_put_varint(&record[size], (int64_t)fix->altitude - prev->altitude);
+	size += gnss_history_put_varint(&record[size], (int64_t)fix->speed - prev->speed);
+	size += gnss_history_put_varint(&record[size], (int64_t)fix->bearing - prev->bearing);
+	return size;
+}
+
+/* Apply the record found at pos to fix, returning the size of the record */
+static uint16_t gnss_history_decode(const struct gnss_history *history, uint16_t *pos,
+				    struct gnss_history_fix *fix)
+{
+	uint16_t size = 0;
+
+	fix->timestamp_ms += gnss_history_get_varint(history, pos, &size);
+	fix->latitude = (int64_t)((uint64_t)fix->latitude +
+				  (uint64_t)gnss_history_get_varint(history, pos, &size));
+	fix->longitude = (int64_t)((uint64_t)fix->longitude +
+				   (uint64_t)gnss_history_get_varint(history, pos, &size));
+	fix->altitude = (int32_t)((uint32_t)fix->altitude +
+				  (uint32_t)gnss_history_get_varint(history, pos, &size));
+	fix->speed += (uint32_t)gnss_history_get_varint(history, pos, &size);
+	fix->bearing += (uint32_t)gnss_history_get_varint(history, pos, &size);
+	return size;
+}
+
+/* Remove the oldest fix, replacing it with the next one if any */
+static void gnss_history_pop(struct gnss_history *history)
+{
+	if (history->count > 1) {
+		history->used -= gnss_history_decode(history, &history->tail, &history->oldest);
+	}
+
+	history->count--;
+}
+
+int gnss_history_init(struct gnss_history *history, const struct gnss_history_config *config)
+{
+	__ASSERT(history != NULL, "history argument must be provided");
+	__ASSERT(config != NULL, "config argument must be provided");
+
+	if ((config->buf == NULL) || (config->buf_size < GNSS_HISTORY_RECORD_SIZE_MAX)) {
+		return -EINVAL;
+	}
+
+	memset(history, 0, sizeof(struct gnss_history));
+	history->buf = config->buf;
+	history->buf_size = config->buf_size;
+	k_mutex_init(&history->lock);
+	return 0;
+}
+
+void gnss_history_push(struct gnss_history *history, const struct gnss_history_fix *fix)
+{
+	uint8_t record[GNSS_HISTORY_RECORD_SIZE_MAX];
+	size_t size;
+	size_t i;
+
+	k_mutex_lock(&history->lock, K_FOREVER);
+
+	if (history->count == 0) {
+		history->oldest = *fix;
+		history->newest = *fix;
+		history->count = 1;
+		goto unlock_return;
+	}
+
+	size = gnss_history_encode(record, &history->newest, fix);
+
+	while ((history->buf_size - history->used) < size) {
+		gnss_history_pop(history);
+	}
+
+	for (i = 0; i < size; i++) {
+		history->buf[history->head] = record[i];
+		history->head = (history->head + 1 == history->buf_size) ? 0 : history->head + 1;
+	}
+
+	history->used += size;
+	history->newest = *fix;
+	history->count++;
+
+unlock_return:
+	k_mutex_unlock(&history->lock);
+}
+
+void gnss_history_push_data(struct gnss_history *history, const struct gnss_data *data)
+{
+	struct gnss_history_fix fix;
+
+	if (data->info.fix_status == GNSS_FIX_STATUS_NO_FIX) {
+		return;
+	}
+
+	fix.timestamp_ms = gnss_history_timestamp_ms(&data->utc);
+	fix.latitude = data->nav_data.latitude;
+	fix.longitude = data->nav_data.longitude;
+	fix.altitude = data->nav_data.altitude;
+	fix.speed = data->nav_data.speed;
+	fix.bearing = data->nav_data.bearing;
+	gnss_history_push(history, &fix);
+}
+
+size_t gnss_history_drain(struct gnss_history *history, struct gnss_history_fix *fixes,
+			  size_t size)
+{
+	size_t drained = 0;
+
+	k_mutex_lock(&history->lock, K_FOREVER);
+
+	while ((drained < size) && (history->count > 0)) {
+		fixes[drained++] = history->oldest;
+		gnss_history_pop(history);
+	}
+
+	k_mutex_unlock(&history->lock);
+	return drained;
+}
+
+size_t gnss_history_foreach(struct gnss_history *history, gnss_history_visit_t visit,
+			    void *user_data)
+{
+	struct gnss_history_fix fix;
+	uint16_t pos;
+	size_t visited = 0;
+
+	k_mutex_lock(&history->lock, K_FOREVER);
+
+	if (history->count == 0) {
+		goto unlock_return;
+	}
+
+	fix = history->oldest;
+	pos = history->tail;
+
+	while (true) {
+		visited++;
+
+		if (!visit(&fix, user_data) || (visited == history->count)) {
+			break;
+		}
+
+		gnss_history_decode(history, &pos, &fix);
+	}
+
+unlock_return:
+	k_mutex_unlock(&history->lock);
+	return visited;
+}
+
+size_t gnss_history_count(struct gnss_history *history)
+{
+	size_t count;
+
+	k_mutex_lock(&history->lock, K_FOREVER);
+	count = history->count;
+	k_mutex_unlock(&history->lock);
+	return count;
+}
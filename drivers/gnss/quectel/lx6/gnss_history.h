@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The GNSS history stores the latest fixes in a caller provided byte ring.
+ *
+ * The oldest fix is kept decoded, every following fix is stored as the
+ * difference with its predecessor, each field encoded as a zigzag varint. Fixes
+ * received at a steady rate while moving take a few bytes per field instead of
+ * the size of struct gnss_data. Once the ring is full, the oldest fixes are
+ * dropped to make room for new ones.
+ *
+ *   static uint8_t my_buf[1024];
+ *
+ *   const struct gnss_history_config config = {
+ *           .buf = my_buf,
+ *           .buf_size = sizeof(my_buf),
+ *   };
+ *
+ *   gnss_history_init(&my_history, &config);
+ *   ...
+ *   gnss_history_push_data(&my_history, data);
+ *   ...
+ *   count = gnss_history_drain(&my_history, fixes, ARRAY_SIZE(fixes));
+ */
+
+#ifndef ZEPHYR_DRIVERS_GNSS_GNSS_HISTORY_H_
+#define ZEPHYR_DRIVERS_GNSS_GNSS_HISTORY_H_
+
+#include <zephyr/drivers/gnss.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+
+/** Fix stored in GNSS history */
+struct gnss_history_fix {
+	/** Milliseconds since 2000-01-01T00:00:00 UTC, or since midnight if date is unknown */
+	uint64_t timestamp_ms;
+	/** Latitude in nano degrees */
+	int64_t latitude;
+	/** Longitude in nano degrees */
+	int64_t longitude;
+	/** Altitude above MSL in millimeters */
+	int32_t altitude;
+	/** Speed in millimeters per second */
+	uint32_t speed;
+	/** Bearing in milli degrees */
+	uint32_t bearing;
+};
+
+/**
+ * @brief Callback invoked for every visited fix
+ *
+ * @retval true to continue visiting fixes
+ * @retval false to stop
+ */
+typedef bool (*gnss_history_visit_t)(const struct gnss_history_fix *fix, void *user_data);
+
+struct gnss_history {
+	uint8_t *buf;
+	uint16_t buf_size;
+	uint16_t head;
+	uint16_t tail;
+	uint16_t used;
+	uint16_t count;
+	struct gnss_history_fix oldest;
+	struct gnss_history_fix newest;
+	struct k_mutex lock;
+};
+
+/** GNSS history configuration structure */
+struct gnss_history_config {
+	/** Buffer in which encoded fixes are stored */
+	uint8_t *buf;
+	/** Size of buffer */
+	uint16_t buf_size;
+};
+
+/**
+ * @brief Initialize a GNSS history instance
+ *
+ * @param history GNSS history instance to initialize
+ * @param config Configuration to apply to GNSS history instance
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if configuration is invalid
+ */
+int gnss_history_init(struct gnss_history *history, const struct gnss_history_config *config);
+
+/**
+ * @brief Append a fix, dropping the oldest fixes if needed
+ *
+ * @param history GNSS history instance
+ * @param fix Fix to append
+ */
+void gnss_history_push(struct gnss_history *history, const struct gnss_history_fix *fix);
+
+/**
+ * @brief Append the fix of published GNSS data, dropping the oldest fixes if needed
+ *
+ * @param history GNSS history instance
+ * @param data Published GNSS data
+ */
+void gnss_history_push_data(struct gnss_history *history, const struct gnss_data *data);
+
+/**
+ * @brief Remove the oldest fixes
+ *
+ * @param history GNSS history instance
+ * @param fixes Destination for removed fixes, oldest first
+ * @param size Maximum number of fixes to remove
+ *
+ * @returns Number of fixes removed
+ */
+size_t gnss_history_drain(struct gnss_history *history, struct gnss_history_fix *fixes,
+			  size_t size);
+
+/**
+ * @brief Visit stored fixes, oldest first, without removing them
+ *
+ * @note Fixes can't be pushed while visited, the callback should be quick
+ *
+ * @param history GNSS history instance
+ * @param visit Callback invoked for every fix
+ * @param user_data User data passed to callback
+ *
+ * @returns Number of fixes visited
+ */
+size_t gnss_history_foreach(struct gnss_history *history, gnss_history_visit_t visit,
+			    void *user_data);
+
+/**
+ * @brief Get number of stored fixes
+ *
+ * @param history GNSS history instance
+ *
+ * @returns Number of stored fixes
+ */
+size_t gnss_history_count(struct gnss_history *history);
+
+#endif /* ZEPHYR_DRIVERS_GNSS_GNSS_HISTORY_H_ */
@@ -8,26 +8,53 @@
 
 #include <string.h>
 #include <stdarg.h>
-#include <stdarg.h>
 
 #include "gnss_nmea0183.h"
 #include "gnss_parse.h"
 
-#define GNSS_NMEA0183_PICO_DEGREES_IN_DEGREE      (1000000000000ULL)
-#define GNSS_NMEA0183_PICO_DEGREES_IN_MINUTE      (GNSS_NMEA0183_PICO_DEGREES_IN_DEGREE / 60ULL)
-#define GNSS_NMEA0183_PICO_DEGREES_IN_NANO_DEGREE (1000ULL)
-#define GNSS_NMEA0183_NANO_KNOTS_IN_MMS           (1943861LL)
+#define LX6_NMEA0183_NANO_DEGREES_IN_DEGREE      (1000000000LL)
+#define LX6_NMEA0183_PICO_DEGREES_IN_NANO_DEGREE (1000U)
+#define LX6_NMEA0183_DDDMM_DIGITS_MAX            (9)
+#define LX6_NMEA0183_NANO_KNOTS_IN_MMS           (1943861LL)
+
+#define LX6_NMEA0183_MESSAGE_SIZE_MIN      (6)
+#define LX6_NMEA0183_MESSAGE_CHECKSUM_SIZE (3)
+
+#define LX6_NMEA0183_GSV_HDR_ARG_CNT (4)
+#define LX6_NMEA0183_GSV_SV_ARG_CNT  (4)
+
+#define LX6_NMEA0183_GSV_PRN_GPS_RANGE      (32)
+#define LX6_NMEA0183_GSV_PRN_SBAS_OFFSET    (87)
+#define LX6_NMEA0183_GSV_PRN_GLONASS_OFFSET (64)
+#define LX6_NMEA0183_GSV_PRN_BEIDOU_OFFSET  (100)
 
-#define GNSS_NMEA0183_MESSAGE_SIZE_MIN      (6)
-#define GNSS_NMEA0183_MESSAGE_CHECKSUM_SIZE (3)
+#define LX6_NMEA0183_GSA_ARG_CNT           (19)
+#define LX6_NMEA0183_GSA_SV_ARG_OFFSET     (3)
+#define LX6_NMEA0183_GSA_DOP_ARG_OFFSET    (15)
+#define LX6_NMEA0183_GSA_SYSTEM_ID_ARG     (18)
+#define LX6_NMEA0183_GSA_PRN_SBAS_RANGE    (64)
+#define LX6_NMEA0183_GSA_PRN_GLONASS_RANGE (96)
+#define LX6_NMEA0183_DOP_MAX               (99999)
 
-#define GNSS_NMEA0183_GSV_HDR_ARG_CNT (4)
-#define GNSS_NMEA0183_GSV_SV_ARG_CNT  (4)
+#define LX6_NMEA0183_GST_ARG_CNT    (10)
+#define LX6_NMEA0183_GST_STDDEV_MAX (99999999)
+
+/*
+ * Minute digit weights in nano degrees, from tens of minutes down to the 10th
+ * decimal. The weights are the historical truncated pico degree weights
+ * (1e12 / 60 scaled per digit) split into nano degrees and a pico degree
+ * remainder, so that the conversion stays bit-exact without a 64-bit division.
+ */
+struct ndeg_minute_increment {
+	uint32_t nano_degrees;
+	uint16_t remainder;
+};
 
-#define GNSS_NMEA0183_GSV_PRN_GPS_RANGE      (32)
-#define GNSS_NMEA0183_GSV_PRN_SBAS_OFFSET    (87)
-#define GNSS_NMEA0183_GSV_PRN_GLONASS_OFFSET (64)
-#define GNSS_NMEA0183_GSV_PRN_BEIDOU_OFFSET  (100)
+static const struct ndeg_minute_increment ndeg_minute_increments[] = {
+	{166666666, 660}, {16666666, 666}, {1666666, 666}, {166666, 666},
+	{16666, 666},     {1666, 666},     {166, 666},     {16, 666},
+	{1, 666},         {0, 166},        {0, 16},        {0, 1},
+};
 
 struct gsv_header_args {
 	const char *message_id;
@@ -74,9 +101,9 @@ static void align_satellite_with_gnss_system(enum gnss_system sv_system,
 {
 	switch (sv_system) {
 	case GNSS_SYSTEM_GPS:
-		if (satellite->prn > GNSS_NMEA0183_GSV_PRN_GPS_RANGE) {
+		if (satellite->prn > LX6_NMEA0183_GSV_PRN_GPS_RANGE) {
 			satellite->system = GNSS_SYSTEM_SBAS;
-			satellite->prn += GNSS_NMEA0183_GSV_PRN_SBAS_OFFSET;
+			satellite->prn += LX6_NMEA0183_GSV_PRN_SBAS_OFFSET;
 			break;
 		}
 
@@ -85,7 +112,7 @@ static void align_satellite_with_gnss_system(enum gnss_system sv_system,
 
 	case GNSS_SYSTEM_GLONASS:
 		satellite->system = GNSS_SYSTEM_GLONASS;
-		satellite->prn -= GNSS_NMEA0183_GSV_PRN_GLONASS_OFFSET;
+		satellite->prn -= LX6_NMEA0183_GSV_PRN_GLONASS_OFFSET;
 		break;
 
 	case GNSS_SYSTEM_GALILEO:
@@ -94,7 +121,7 @@ static void align_satellite_with_gnss_system(enum gnss_system sv_system,
 
 	case GNSS_SYSTEM_BEIDOU:
 		satellite->system = GNSS_SYSTEM_BEIDOU;
-		satellite->prn -= GNSS_NMEA0183_GSV_PRN_BEIDOU_OFFSET;
+		satellite->prn -= LX6_NMEA0183_GSV_PRN_BEIDOU_OFFSET;
 		break;
 
 	case GNSS_SYSTEM_QZSS:
@@ -108,7 +135,7 @@ static void align_satellite_with_gnss_system(enum gnss_system sv_system,
 	}
 }
 
-uint8_t gnss_nmea0183_checksum(const char *str)
+uint8_t lx6_nmea0183_checksum(const char *str)
 {
 	uint8_t checksum = 0;
 	size_t end;
@@ -123,7 +150,7 @@ uint8_t gnss_nmea0183_checksum(const char *str)
 	return checksum;
 }
 
-int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...)
+int lx6_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...)
 {
 	va_list ap;
 	uint8_t checksum;
@@ -133,7 +160,7 @@ int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...)
 	__ASSERT(str != NULL, "str argument must be provided");
 	__ASSERT(fmt != NULL, "fmt argument must be provided");
 
-	if (size < GNSS_NMEA0183_MESSAGE_SIZE_MIN) {
+	if (size < LX6_NMEA0183_MESSAGE_SIZE_MIN) {
 		return -ENOMEM;
 	}
 
@@ -147,13 +174,13 @@ int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...)
 		return -EINVAL;
 	}
 
-	len = pos + GNSS_NMEA0183_MESSAGE_CHECKSUM_SIZE;
+	len = pos + LX6_NMEA0183_MESSAGE_CHECKSUM_SIZE;
 
 	if ((size - 1) < len) {
 		return -ENOMEM;
 	}
 
-	checksum = gnss_nmea0183_checksum(&str[1]);
+	checksum = lx6_nmea0183_checksum(&str[1]);
 	pos = snprintk(&str[pos], size - pos, "*%02X", checksum);
 	if (pos != 3) {
 		return -EINVAL;
@@ -163,90 +190,77 @@ int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...)
 	return len;
 }
 
-int gnss_nmea0183_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg)
+int lx6_nmea0183_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg)
 {
-	uint64_t pico_degrees = 0;
-	int8_t decimal = -1;
-	int8_t pos = 0;
-	uint64_t increment;
+	const char *pos = ddmm_mmmm;
+	uint32_t ddmm = 0;
+	uint32_t minutes;
+	uint32_t nano_degrees;
+	uint32_t remainder;
+	uint8_t digits = 0;
+	uint8_t increment;
 
 	__ASSERT(ddmm_mmmm != NULL, "ddmm_mmmm argument must be provided");
 	__ASSERT(ndeg != NULL, "ndeg argument must be provided");
 
-	/* Find decimal */
-	while (ddmm_mmmm[pos] != '\0') {
-		/* Verify if char is decimal */
-		if (ddmm_mmmm[pos] == '.') {
-			decimal = pos;
-			break;
+	/* Accumulate degrees and whole minutes up to decimal */
+	while (*pos != '.') {
+		/* Verify char is decimal, this also rejects a missing decimal */
+		if ((*pos < '0') || (*pos > '9') || (digits == LX6_NMEA0183_DDDMM_DIGITS_MAX)) {
+			return -EINVAL;
 		}
 
-		/* Advance position */
+		ddmm = (ddmm * 10) + (*pos - '0');
+		digits++;
 		pos++;
 	}
 
-	/* Verify decimal was found and placed correctly */
-	if (decimal < 1) {
+	/* Verify decimal was placed correctly */
+	if (digits == 0) {
 		return -EINVAL;
 	}
 
 	/* Validate potential degree fraction is within bounds */
-	if (decimal > 1 && ddmm_mmmm[decimal - 2] > '5') {
+	minutes = ddmm % 100;
+	if (minutes > 59) {
 		return -EINVAL;
 	}
 
-	/* Convert minute fraction to pico degrees and add it to pico_degrees */
-	pos = decimal + 1;
-	increment = (GNSS_NMEA0183_PICO_DEGREES_IN_MINUTE / 10);
-	while (ddmm_mmmm[pos] != '\0') {
+	/* Convert whole minutes to nano degrees */
+	nano_degrees = (ndeg_minute_increments[0].nano_degrees * (minutes / 10)) +
+		       (ndeg_minute_increments[1].nano_degrees * (minutes % 10));
+	remainder = (ndeg_minute_increments[0].remainder * (minutes / 10)) +
+		    (ndeg_minute_increments[1].remainder * (minutes % 10));
+
+	/* Convert minute fraction to nano degrees and add it to nano_degrees */
+	pos++;
+	increment = 2;
+	while (*pos != '\0') {
 		/* Verify char is decimal */
-		if (ddmm_mmmm[pos] < '0' || ddmm_mmmm[pos] > '9') {
+		if ((*pos < '0') || (*pos > '9')) {
 			return -EINVAL;
 		}
 
-		/* Add increment to pico_degrees */
-		pico_degrees += (ddmm_mmmm[pos] - '0') * increment;
-
-		/* Update unit */
-		increment /= 10;
+		/* Digits beyond the increments table do not contribute */
+		if (increment < ARRAY_SIZE(ndeg_minute_increments)) {
+			nano_degrees += ndeg_minute_increments[increment].nano_degrees * (*pos - '0');
+			remainder += ndeg_minute_increments[increment].remainder * (*pos - '0');
+			increment++;
+		}
 
 		/* Increment position */
 		pos++;
 	}
 
-	/* Convert minutes and degrees to pico_degrees */
-	pos = decimal - 1;
-	increment = GNSS_NMEA0183_PICO_DEGREES_IN_MINUTE;
-	while (pos >= 0) {
-		/* Check if digit switched from minutes to degrees */
-		if ((decimal - pos) == 3) {
-			/* Reset increment to degrees */
-			increment = GNSS_NMEA0183_PICO_DEGREES_IN_DEGREE;
-		}
-
-		/* Verify char is decimal */
-		if (ddmm_mmmm[pos] < '0' || ddmm_mmmm[pos] > '9') {
-			return -EINVAL;
-		}
-
-		/* Add increment to pico_degrees */
-		pico_degrees += (ddmm_mmmm[pos] - '0') * increment;
-
-		/* Update unit */
-		increment *= 10;
-
-		/* Decrement position */
-		pos--;
-	}
-
-	/* Convert to nano degrees */
-	*ndeg = (int64_t)(pico_degrees / GNSS_NMEA0183_PICO_DEGREES_IN_NANO_DEGREE);
+	/* Add degrees and the carry of the accumulated pico degree remainders */
+	*ndeg = ((int64_t)(ddmm / 100) * LX6_NMEA0183_NANO_DEGREES_IN_DEGREE) + nano_degrees +
+		(remainder / LX6_NMEA0183_PICO_DEGREES_IN_NANO_DEGREE);
 	return 0;
 }
 
-bool gnss_nmea0183_validate_message(char **argv, uint16_t argc)
+bool lx6_nmea0183_validate_message(char **argv, uint16_t argc)
 {
-	int32_t tmp = 0;
+	uint8_t expected;
 	uint8_t checksum = 0;
 	size_t len;
 
@@ -277,34 +291,33 @@ bool gnss_nmea0183_validate_message(char **argv, uint16_t argc)
 		checksum ^= ',';
 	}
 
-	if ((gnss_parse_atoi(argv[argc - 1], 16, &tmp) < 0) || (tmp > UINT8_MAX) || (tmp < 0)) {
+	if (lx6_parse_hex_to_u8(argv[argc - 1], 0, UINT8_MAX, &expected) < 0) {
 		return false;
 	}
 
-	return checksum == (uint8_t)tmp;
+	return checksum == expected;
 }
 
-int gnss_nmea0183_knots_to_mms(const char *str, int64_t *mms)
+int lx6_nmea0183_knots_to_mms(const char *str, int64_t *mms)
 {
 	int ret;
 
 	__ASSERT(str != NULL, "str argument must be provided");
 	__ASSERT(mms != NULL, "mms argument must be provided");
 
-	ret = gnss_parse_dec_to_nano(str, mms);
+	ret = lx6_parse_dec_to_nano(str, mms);
 	if (ret < 0) {
 		return ret;
 	}
 
-	*mms = (*mms) / GNSS_NMEA0183_NANO_KNOTS_IN_MMS;
+	*mms = (*mms) / LX6_NMEA0183_NANO_KNOTS_IN_MMS;
 	return 0;
 }
 
-int gnss_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc)
+int lx6_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc)
 {
 	int64_t i64;
-	int32_t i32;
-	char part[3] = {0};
+	uint32_t u32;
 
 	__ASSERT(hhmmss != NULL, "hhmmss argument must be provided");
 	__ASSERT(utc != NULL, "utc argument must be provided");
@@ -313,21 +326,19 @@ int gnss_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc)
 		return -EINVAL;
 	}
 
-	memcpy(part, hhmmss, 2);
-	if ((gnss_parse_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 23)) {
+	if ((lx6_parse_fixed_digits(hhmmss, 2, &u32) < 0) || (u32 > 23)) {
 		return -EINVAL;
 	}
 
-	utc->hour = (uint8_t)i32;
+	utc->hour = (uint8_t)u32;
 
-	memcpy(part, &hhmmss[2], 2);
-	if ((gnss_parse_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 59)) {
+	if ((lx6_parse_fixed_digits(&hhmmss[2], 2, &u32) < 0) || (u32 > 59)) {
 		return -EINVAL;
 	}
 
-	utc->minute = (uint8_t)i32;
+	utc->minute = (uint8_t)u32;
 
-	if ((gnss_parse_dec_to_milli(&hhmmss[4], &i64) < 0) || (i64 < 0) || (i64 > 59999)) {
+	if ((lx6_parse_dec_to_milli(&hhmmss[4], &i64) < 0) || (i64 < 0) || (i64 > 59999)) {
 		return -EINVAL;
 	}
 
@@ -335,10 +346,9 @@ int gnss_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc)
 	return 0;
 }
 
-int gnss_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc)
+int lx6_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc)
 {
-	int32_t i32;
-	char part[3] = {0};
+	uint32_t u32;
 
 	__ASSERT(ddmmyy != NULL, "ddmmyy argument must be provided");
 	__ASSERT(utc != NULL, "utc argument must be provided");
@@ -347,33 +357,72 @@ int gnss_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc)
 		return -EINVAL;
 	}
 
-	memcpy(part, ddmmyy, 2);
-	if ((gnss_parse_atoi(part, 10, &i32) < 0) || (i32 < 1) || (i32 > 31)) {
+	if ((lx6_parse_fixed_digits(ddmmyy, 2, &u32) < 0) || (u32 < 1) || (u32 > 31)) {
+		return -EINVAL;
+	}
+
+	utc->month_day = (uint8_t)u32;
+
+	if ((lx6_parse_fixed_digits(&ddmmyy[2], 2, &u32) < 0) || (u32 < 1) || (u32 > 12)) {
+		return -EINVAL;
+	}
+
+	utc->month = (uint8_t)u32;
+
+	if ((lx6_parse_fixed_digits(&ddmmyy[4], 2, &u32) < 0) || (u32 > 99)) {
 		return -EINVAL;
 	}
 
-	utc->month_day = (uint8_t)i32;
+	utc->century_year = (uint8_t)u32;
+	return 0;
+}
+
+static int parse_coordinates(const char **argv, struct navigation_data *nav_data)
+{
+	/* Validate cardinal directions */
+	if (((argv[1][0] != 'N') && (argv[1][0] != 'S')) ||
+	    ((argv[3][0] != 'E') && (argv[3][0] != 'W'))) {
+		return -EINVAL;
+	}
 
-	memcpy(part, &ddmmyy[2], 2);
-	if ((gnss_parse_atoi(part, 10, &i32) < 0) || (i32 < 1) || (i32 > 12)) {
+	/* Parse coordinates */
+	if ((lx6_nmea0183_ddmm_mmmm_to_ndeg(argv[0], &nav_data->latitude) < 0) ||
+	    (lx6_nmea0183_ddmm_mmmm_to_ndeg(argv[2], &nav_data->longitude) < 0)) {
 		return -EINVAL;
 	}
 
-	utc->month = (uint8_t)i32;
+	/* Align sign of coordinates with cardinal directions */
+	nav_data->latitude = argv[1][0] == 'N' ? nav_data->latitude : -nav_data->latitude;
+	nav_data->longitude = argv[3][0] == 'E' ? nav_data->longitude : -nav_data->longitude;
+	return 0;
+}
+
+static int parse_speed(const char *knots, struct navigation_data *nav_data)
+{
+	int64_t tmp;
 
-	memcpy(part, &ddmmyy[4], 2);
-	if ((gnss_parse_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 99)) {
+	if ((lx6_nmea0183_knots_to_mms(knots, &tmp) < 0) || (tmp > UINT32_MAX)) {
 		return -EINVAL;
 	}
 
-	utc->century_year = (uint8_t)i32;
+	nav_data->speed = (uint32_t)tmp;
 	return 0;
 }
 
-int gnss_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *data)
+static int parse_bearing(const char *bearing, struct navigation_data *nav_data)
 {
 	int64_t tmp;
 
+	if ((lx6_parse_dec_to_milli(bearing, &tmp) < 0) || (tmp > 359999) || (tmp < 0)) {
+		return -EINVAL;
+	}
+
+	nav_data->bearing = (uint32_t)tmp;
+	return 0;
+}
+
+int lx6_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *data)
+{
 	__ASSERT(argv != NULL, "argv argument must be provided");
 	__ASSERT(data != NULL, "data argument must be provided");
 
@@ -391,45 +440,27 @@ int gnss_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *
 	}
 
 	/* Parse UTC time */
-	if ((gnss_nmea0183_parse_hhmmss(argv[1], &data->utc) < 0)) {
-		return -EINVAL;
-	}
-
-	/* Validate cardinal directions */
-	if (((argv[4][0] != 'N') && (argv[4][0] != 'S')) ||
-	    ((argv[6][0] != 'E') && (argv[6][0] != 'W'))) {
+	if ((lx6_nmea0183_parse_hhmmss(argv[1], &data->utc) < 0)) {
 		return -EINVAL;
 	}
 
 	/* Parse coordinates */
-	if ((gnss_nmea0183_ddmm_mmmm_to_ndeg(argv[3], &data->nav_data.latitude) < 0) ||
-	    (gnss_nmea0183_ddmm_mmmm_to_ndeg(argv[5], &data->nav_data.longitude) < 0)) {
+	if (parse_coordinates(&argv[3], &data->nav_data) < 0) {
 		return -EINVAL;
 	}
 
-	/* Align sign of coordinates with cardinal directions */
-	data->nav_data.latitude =
-		argv[4][0] == 'N' ? data->nav_data.latitude : -data->nav_data.latitude;
-
-	data->nav_data.longitude =
-		argv[6][0] == 'E' ? data->nav_data.longitude : -data->nav_data.longitude;
-
 	/* Parse speed */
-	if ((gnss_nmea0183_knots_to_mms(argv[7], &tmp) < 0) || (tmp > UINT32_MAX)) {
+	if (parse_speed(argv[7], &data->nav_data) < 0) {
 		return -EINVAL;
 	}
 
-	data->nav_data.speed = (uint32_t)tmp;
-
 	/* Parse bearing */
-	if ((gnss_parse_dec_to_milli(argv[8], &tmp) < 0) || (tmp > 359999) || (tmp < 0)) {
+	if (parse_bearing(argv[8], &data->nav_data) < 0) {
 		return -EINVAL;
 	}
 
-	data->nav_data.bearing = (uint32_t)tmp;
-
 	/* Parse UTC date */
-	if ((gnss_nmea0183_parse_ddmmyy(argv[9], &data->utc) < 0)) {
+	if ((lx6_nmea0183_parse_ddmmyy(argv[9], &data->utc) < 0)) {
 		return -EINVAL;
 	}
 
@@ -476,9 +507,8 @@ static enum gnss_fix_status fix_status_from_fix_quality(enum gnss_fix_quality fi
 	return fix_status;
 }
 
-int gnss_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *data)
+int lx6_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *data)
 {
-	int32_t tmp32;
 	int64_t tmp64;
 
 	__ASSERT(argv != NULL, "argv argument must be provided");
@@ -500,22 +530,22 @@ int gnss_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *
 		return 0;
 	}
 
-	/* Parse number of satellites */
-	if ((gnss_parse_atoi(argv[7], 10, &tmp32) < 0) || (tmp32 > UINT16_MAX) || (tmp32 < 0)) {
+	/* Parse number of satellites, an empty field being accepted as none */
+	data->info.satellites_cnt = 0;
+	if ((argv[7][0] != '\0') &&
+	    (lx6_parse_dec_to_u16(argv[7], 0, UINT16_MAX, &data->info.satellites_cnt) < 0)) {
 		return -EINVAL;
 	}
 
-	data->info.satellites_cnt = (uint16_t)tmp32;
-
 	/* Parse HDOP */
-	if ((gnss_parse_dec_to_milli(argv[8], &tmp64) < 0) || (tmp64 > UINT32_MAX) || (tmp64 < 0)) {
+	if ((lx6_parse_dec_to_milli(argv[8], &tmp64) < 0) || (tmp64 > UINT32_MAX) || (tmp64 < 0)) {
 		return -EINVAL;
 	}
 
 	data->info.hdop = (uint16_t)tmp64;
 
 	/* Parse altitude */
-	if ((gnss_parse_dec_to_milli(argv[9], &tmp64) < 0) || (tmp64 > INT32_MAX) ||
+	if ((lx6_parse_dec_to_milli(argv[9], &tmp64) < 0) || (tmp64 > INT32_MAX) ||
 	    (tmp64 < INT32_MIN)) {
 		return -EINVAL;
 	}
@@ -524,57 +554,189 @@ int gnss_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *
 	return 0;
 }
 
+static int parse_faa_mode(const char *str, enum gnss_fix_quality *fix_quality)
+{
+	switch (str[0]) {
+	case 'A':
+		*fix_quality = GNSS_FIX_QUALITY_GNSS_SPS;
+		break;
+
+	case 'D':
+		*fix_quality = GNSS_FIX_QUALITY_DGNSS;
+		break;
+
+	case 'E':
+		*fix_quality = GNSS_FIX_QUALITY_ESTIMATED;
+		break;
+
+	case 'N':
+		*fix_quality = GNSS_FIX_QUALITY_INVALID;
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int lx6_nmea0183_parse_gll(const char **argv, uint16_t argc, struct gnss_data *data)
+{
+	__ASSERT(argv != NULL, "argv argument must be provided");
+	__ASSERT(data != NULL, "data argument must be provided");
+
+	if (argc < 8) {
+		return -EINVAL;
+	}
+
+	/* Parse fix quality from mode indicator, which is absent before NMEA 2.3 */
+	data->info.fix_quality = GNSS_FIX_QUALITY_GNSS_SPS;
+	if ((argc > 8) && (parse_faa_mode(argv[7], &data->info.fix_quality) < 0)) {
+		return -EINVAL;
+	}
+
+	if (argv[6][0] == 'V') {
+		data->info.fix_quality = GNSS_FIX_QUALITY_INVALID;
+	} else if (argv[6][0] != 'A') {
+		return -EINVAL;
+	}
+
+	data->info.fix_status = fix_status_from_fix_quality(data->info.fix_quality);
+
+	/* Validate GNSS has fix */
+	if (data->info.fix_status == GNSS_FIX_STATUS_NO_FIX) {
+		return 0;
+	}
+
+	/* Parse UTC time */
+	if ((lx6_nmea0183_parse_hhmmss(argv[5], &data->utc) < 0)) {
+		return -EINVAL;
+	}
+
+	/* Parse coordinates */
+	if (parse_coordinates(&argv[1], &data->nav_data) < 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int lx6_nmea0183_parse_vtg(const char **argv, uint16_t argc, struct gnss_data *data)
+{
+	__ASSERT(argv != NULL, "argv argument must be provided");
+	__ASSERT(data != NULL, "data argument must be provided");
+
+	if (argc < 10) {
+		return -EINVAL;
+	}
+
+	/* Validate GNSS has fix, course and speed are empty otherwise */
+	if ((argv[1][0] == '\0') || (argv[5][0] == '\0')) {
+		return 0;
+	}
+
+	/* Parse bearing */
+	if (parse_bearing(argv[1], &data->nav_data) < 0) {
+		return -EINVAL;
+	}
+
+	/* Parse speed */
+	if (parse_speed(argv[5], &data->nav_data) < 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int lx6_nmea0183_parse_zda(const char **argv, uint16_t argc, struct gnss_time *utc)
+{
+	uint16_t year;
+	uint8_t month_day;
+	uint8_t month;
+
+	__ASSERT(argv != NULL, "argv argument must be provided");
+	__ASSERT(utc != NULL, "utc argument must be provided");
+
+	if (argc < 7) {
+		return -EINVAL;
+	}
+
+	/* Validate time is known */
+	if ((argv[1][0] == '\0') || (argv[4][0] == '\0')) {
+		return 0;
+	}
+
+	if ((lx6_parse_dec_to_u8(argv[2], 1, 31, &month_day) < 0) ||
+	    (lx6_parse_dec_to_u8(argv[3], 1, 12, &month) < 0) ||
+	    (lx6_parse_dec_to_u16(argv[4], 2000, 2099, &year) < 0)) {
+		return -EINVAL;
+	}
+
+	/* Parse UTC time */
+	if ((lx6_nmea0183_parse_hhmmss(argv[1], utc) < 0)) {
+		return -EINVAL;
+	}
+
+	utc->month_day = month_day;
+	utc->month = month;
+	utc->century_year = (uint8_t)(year % 100);
+	return 0;
+}
+
 static int parse_gsv_svs(struct gnss_satellite *satellites, const struct gsv_sv_args *svs,
 			 uint16_t svs_size)
 {
-	int32_t i32;
+	uint16_t u16;
+	uint8_t u8;
 
 	for (uint16_t i = 0; i < svs_size; i++) {
 		/* Parse PRN */
-		if ((gnss_parse_atoi(svs[i].prn, 10, &i32) < 0) || (i32 < 0) ||
-		    (i32 > UINT16_MAX)) {
+		if (lx6_parse_dec_to_u16(svs[i].prn, 0, UINT16_MAX, &u16) < 0) {
 			return -EINVAL;
 		}
 
-		satellites[i].prn = (uint16_t)i32;
+		satellites[i].prn = u16;
 
-		/* Parse elevation */
-		if ((gnss_parse_atoi(svs[i].elevation, 10, &i32) < 0) || (i32 < 0) || (i32 > 90)) {
+		/* Parse elevation, which is empty until the satellite is located */
+		u8 = 0;
+		if ((svs[i].elevation[0] != '\0') &&
+		    (lx6_parse_dec_to_u8(svs[i].elevation, 0, 90, &u8) < 0)) {
 			return -EINVAL;
 		}
 
-		satellites[i].elevation = (uint8_t)i32;
+		satellites[i].elevation = u8;
 
-		/* Parse azimuth */
-		if ((gnss_parse_atoi(svs[i].azimuth, 10, &i32) < 0) || (i32 < 0) || (i32 > 359)) {
+		/* Parse azimuth, which is empty until the satellite is located */
+		u16 = 0;
+		if ((svs[i].azimuth[0] != '\0') &&
+		    (lx6_parse_dec_to_u16(svs[i].azimuth, 0, 359, &u16) < 0)) {
 			return -EINVAL;
 		}
 
-		satellites[i].azimuth = (uint16_t)i32;
+		satellites[i].azimuth = u16;
 
 		/* Parse SNR */
-		if (strlen(svs[i].snr) == 0) {
+		if (svs[i].snr[0] == '\0') {
 			satellites[i].snr = 0;
 			satellites[i].is_tracked = false;
 			continue;
 		}
 
-		if ((gnss_parse_atoi(svs[i].snr, 10, &i32) < 0) || (i32 < 0) || (i32 > 99)) {
+		if (lx6_parse_dec_to_u8(svs[i].snr, 0, 99, &u8) < 0) {
 			return -EINVAL;
 		}
 
-		satellites[i].snr = (uint16_t)i32;
+		satellites[i].snr = u8;
 		satellites[i].is_tracked = true;
 	}
 
 	return 0;
 }
 
-int gnss_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
-				   struct gnss_nmea0183_gsv_header *header)
+int lx6_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
+				  struct lx6_nmea0183_gsv_header *header)
 {
 	const struct gsv_header_args *args = (const struct gsv_header_args *)argv;
-	int i32;
 
 	__ASSERT(argv != NULL, "argv argument must be provided");
 	__ASSERT(header != NULL, "header argument must be provided");
@@ -589,33 +751,26 @@ int gnss_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
 	}
 
 	/* Parse number of messages */
-	if ((gnss_parse_atoi(args->number_of_messages, 10, &i32) < 0) || (i32 < 0) ||
-	    (i32 > UINT16_MAX)) {
+	if (lx6_parse_dec_to_u16(args->number_of_messages, 0, UINT16_MAX,
+				 &header->number_of_messages) < 0) {
 		return -EINVAL;
 	}
 
-	header->number_of_messages = (uint16_t)i32;
-
 	/* Parse message number */
-	if ((gnss_parse_atoi(args->message_number, 10, &i32) < 0) || (i32 < 0) ||
-	    (i32 > UINT16_MAX)) {
+	if (lx6_parse_dec_to_u16(args->message_number, 0, UINT16_MAX, &header->message_number) <
+	    0) {
 		return -EINVAL;
 	}
 
-	header->message_number = (uint16_t)i32;
-
-	/* Parse message number */
-	if ((gnss_parse_atoi(args->numver_of_svs, 10, &i32) < 0) || (i32 < 0) ||
-	    (i32 > UINT16_MAX)) {
+	/* Parse number of space-vehicles */
+	if (lx6_parse_dec_to_u16(args->numver_of_svs, 0, UINT16_MAX, &header->number_of_svs) < 0) {
 		return -EINVAL;
 	}
-
-	header->number_of_svs = (uint16_t)i32;
 	return 0;
 }
 
-int gnss_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_satellite *satellites,
-				uint16_t size)
+int lx6_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_satellite *satellites,
+			       uint16_t size)
 {
 	const struct gsv_header_args *header_args = (const struct gsv_header_args *)argv;
 	const struct gsv_sv_args *sv_args = (const struct gsv_sv_args *)(argv + 4);
@@ -629,7 +784,7 @@ int gnss_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_sa
 		return 0;
 	}
 
-	sv_args_size = (argc - GNSS_NMEA0183_GSV_HDR_ARG_CNT) / GNSS_NMEA0183_GSV_SV_ARG_CNT;
+	sv_args_size = (argc - LX6_NMEA0183_GSV_HDR_ARG_CNT) / LX6_NMEA0183_GSV_SV_ARG_CNT;
 
 	if (size < sv_args_size) {
 		return -ENOMEM;
@@ -649,3 +804,160 @@ int gnss_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_sa
 
 	return (int)sv_args_size;
 }
+
+static int gnss_system_from_gsa_system_id(const char *system_id, enum gnss_system *sv_system)
+{
+	if ((system_id[0] == '\0') || (system_id[1] != '\0')) {
+		return -EINVAL;
+	}
+
+	switch (system_id[0]) {
+	case '1':
+		*sv_system = GNSS_SYSTEM_GPS;
+		break;
+	case '2':
+		*sv_system = GNSS_SYSTEM_GLONASS;
+		break;
+	case '3':
+		*sv_system = GNSS_SYSTEM_GALILEO;
+		break;
+	case '4':
+		*sv_system = GNSS_SYSTEM_BEIDOU;
+		break;
+	case '5':
+		*sv_system = GNSS_SYSTEM_QZSS;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int gnss_system_from_gsa_prn(uint16_t prn, enum gnss_system *sv_system)
+{
+	/* GPS and SBAS are told apart when aligning the satellite */
+	if (prn <= LX6_NMEA0183_GSA_PRN_SBAS_RANGE) {
+		*sv_system = GNSS_SYSTEM_GPS;
+		return 0;
+	}
+
+	if (prn <= LX6_NMEA0183_GSA_PRN_GLONASS_RANGE) {
+		*sv_system = GNSS_SYSTEM_GLONASS;
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+static int parse_gsa_dop(const char *str, uint32_t *dop)
+{
+	int64_t tmp;
+
+	if ((lx6_parse_dec_to_milli(str, &tmp) < 0) || (tmp < 0) || (tmp > LX6_NMEA0183_DOP_MAX)) {
+		return -EINVAL;
+	}
+
+	*dop = (uint32_t)tmp;
+	return 0;
+}
+
+int lx6_nmea0183_parse_gsa(const char **argv, uint16_t argc, struct lx6_nmea0183_gsa *gsa)
+{
+	const struct gsv_header_args *header_args = (const struct gsv_header_args *)argv;
+	struct gnss_satellite satellite;
+	enum gnss_system sv_system;
+	bool combined;
+	uint16_t prn;
+
+	__ASSERT(argv != NULL, "argv argument must be provided");
+	__ASSERT(gsa != NULL, "gsa argument must be provided");
+
+	if (argc < LX6_NMEA0183_GSA_ARG_CNT) {
+		return -EINVAL;
+	}
+
+	/* Parse dilutions of precision */
+	if ((parse_gsa_dop(argv[LX6_NMEA0183_GSA_DOP_ARG_OFFSET], &gsa->dop.pdop) < 0) ||
+	    (parse_gsa_dop(argv[LX6_NMEA0183_GSA_DOP_ARG_OFFSET + 1], &gsa->dop.hdop) < 0) ||
+	    (parse_gsa_dop(argv[LX6_NMEA0183_GSA_DOP_ARG_OFFSET + 2], &gsa->dop.vdop) < 0)) {
+		return -EINVAL;
+	}
+
+	/* Parse GNSS sv_system from system id if present, then from talker */
+	combined = false;
+	if (argc > LX6_NMEA0183_GSA_ARG_CNT) {
+		if (gnss_system_from_gsa_system_id(argv[LX6_NMEA0183_GSA_SYSTEM_ID_ARG],
+						   &sv_system) < 0) {
+			return -EINVAL;
+		}
+	} else if (header_args->message_id[2] == 'N') {
+		combined = true;
+	} else if (gnss_system_from_gsv_header_args(header_args, &sv_system) < 0) {
+		return -EINVAL;
+	}
+
+	/* Parse space-vehicles used for fix, which are followed by empty fields */
+	gsa->svs_size = 0;
+	for (uint16_t i = 0; i < LX6_NMEA0183_GSA_SVS_MAX; i++) {
+		if (argv[LX6_NMEA0183_GSA_SV_ARG_OFFSET + i][0] == '\0') {
+			continue;
+		}
+
+		if (lx6_parse_dec_to_u16(argv[LX6_NMEA0183_GSA_SV_ARG_OFFSET + i], 1, UINT16_MAX,
+					 &prn) < 0) {
+			return -EINVAL;
+		}
+
+		if (combined && (gnss_system_from_gsa_prn(prn, &sv_system) < 0)) {
+			continue;
+		}
+
+		satellite.prn = prn;
+		satellite.system = sv_system;
+		align_satellite_with_gnss_system(sv_system, &satellite);
+
+		gsa->svs[gsa->svs_size].system = satellite.system;
+		gsa->svs[gsa->svs_size].prn = satellite.prn;
+		gsa->svs_size++;
+	}
+
+	return 0;
+}
+
+static int parse_gst_stddev(const char *str, uint32_t *stddev)
+{
+	int64_t tmp;
+
+	if ((lx6_parse_dec_to_milli(str, &tmp) < 0) || (tmp < 0) ||
+	    (tmp > LX6_NMEA0183_GST_STDDEV_MAX)) {
+		return -EINVAL;
+	}
+
+	*stddev = (uint32_t)tmp;
+	return 0;
+}
+
+int lx6_nmea0183_parse_gst(const char **argv, uint16_t argc, struct lx6_nmea0183_gst *gst)
+{
+	__ASSERT(argv != NULL, "argv argument must be provided");
+	__ASSERT(gst != NULL, "gst argument must be provided");
+
+	if (argc < LX6_NMEA0183_GST_ARG_CNT) {
+		return -EINVAL;
+	}
+
+	/* Validate GNSS has fix, statistics are empty otherwise */
+	if ((argv[6][0] == '\0') || (argv[7][0] == '\0') || (argv[8][0] == '\0')) {
+		return -ENODATA;
+	}
+
+	/* Parse standard deviations of position */
+	if ((parse_gst_stddev(argv[6], &gst->latitude_stddev) < 0) ||
+	    (parse_gst_stddev(argv[7], &gst->longitude_stddev) < 0) ||
+	    (parse_gst_stddev(argv[8], &gst->altitude_stddev) < 0)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
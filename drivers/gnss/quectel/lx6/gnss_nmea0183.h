@@ -4,8 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#ifndef ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_H_
-#define ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_H_
+#ifndef ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_H_
+#define ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_H_
 
 #include <zephyr/drivers/gnss.h>
 
@@ -18,7 +18,7 @@
  *
  * @retval checksum
  */
-uint8_t gnss_nmea0183_checksum(const char *str);
+uint8_t lx6_nmea0183_checksum(const char *str);
 
 /**
  * @brief Encapsulate str in NMEA0183 message format
@@ -32,7 +32,7 @@ uint8_t gnss_nmea0183_checksum(const char *str);
  *
  * @retval checksum
  */
-int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...);
+int lx6_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...);
 
 /**
  * @brief Computes and validates checksum
@@ -43,7 +43,7 @@ int gnss_nmea0183_snprintk(char *str, size_t size, const char *fmt, ...);
  * @retval true if message is intact
  * @retval false if message is corrupted
  */
-bool gnss_nmea0183_validate_message(char **argv, uint16_t argc);
+bool lx6_nmea0183_validate_message(char **argv, uint16_t argc);
 
 /**
  * @brief Parse a ddmm.mmmm formatted angle to nano degrees
@@ -56,7 +56,7 @@ bool gnss_nmea0183_validate_message(char **argv, uint16_t argc);
  * @retval -EINVAL if ddmm_mmmm argument is invalid
  * @retval 0 if parsed successfully
  */
-int gnss_nmea0183_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg);
+int lx6_nmea0183_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg);
 
 /**
  * @brief Parse knots to millimeters pr second
@@ -69,7 +69,7 @@ int gnss_nmea0183_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg);
  * @retval -EINVAL if str could not be parsed or if speed is negative
  * @retval 0 if parsed successfully
  */
-int gnss_nmea0183_knots_to_mms(const char *str, int64_t *mms);
+int lx6_nmea0183_knots_to_mms(const char *str, int64_t *mms);
 
 /**
  * @brief Parse hhmmss.sss to struct gnss_time
@@ -83,7 +83,7 @@ int gnss_nmea0183_knots_to_mms(const char *str, int64_t *mms);
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if parsed successfully
  */
-int gnss_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc);
+int lx6_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc);
 
 /**
  * @brief Parse ddmmyy to unsigned integers
@@ -96,7 +96,7 @@ int gnss_nmea0183_parse_hhmmss(const char *hhmmss, struct gnss_time *utc);
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if parsed successfully
  */
-int gnss_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc);
+int lx6_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc);
 
 /**
  * @brief Parses NMEA0183 RMC message
@@ -111,7 +111,7 @@ int gnss_nmea0183_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc);
  * @retval 0 if successful
  * @retval -EINVAL if input is invalid
  */
-int gnss_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *data);
+int lx6_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *data);
 
 /**
  * @brief Parses NMEA0183 GGA message
@@ -127,10 +127,55 @@ int gnss_nmea0183_parse_rmc(const char **argv, uint16_t argc, struct gnss_data *
  * @retval 0 if successful
  * @retval -EINVAL if input is invalid
  */
-int gnss_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *data);
+int lx6_nmea0183_parse_gga(const char **argv, uint16_t argc, struct gnss_data *data);
+
+/**
+ * @brief Parses NMEA0183 GLL message
+ *
+ * @details Parses the GNSS fix quality and status, time, latitude and longitude
+ * from the NMEA0183 GLL message provided as an array of strings split by ','
+ *
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param data Destination for data parsed from NMEA0183 GLL message
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if input is invalid
+ */
+int lx6_nmea0183_parse_gll(const char **argv, uint16_t argc, struct gnss_data *data);
+
+/**
+ * @brief Parses NMEA0183 VTG message
+ *
+ * @details Parses the bearing and speed from the NMEA0183 VTG message provided
+ * as an array of strings split by ','
+ *
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param data Destination for data parsed from NMEA0183 VTG message
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if input is invalid
+ */
+int lx6_nmea0183_parse_vtg(const char **argv, uint16_t argc, struct gnss_data *data);
+
+/**
+ * @brief Parses NMEA0183 ZDA message
+ *
+ * @details Parses the time and date from the NMEA0183 ZDA message provided as
+ * an array of strings split by ','
+ *
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param utc Destination for time and date parsed from NMEA0183 ZDA message
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if input is invalid
+ */
+int lx6_nmea0183_parse_zda(const char **argv, uint16_t argc, struct gnss_time *utc);
 
 /** GSV header structure */
-struct gnss_nmea0183_gsv_header {
+struct lx6_nmea0183_gsv_header {
 	/** Indicates the system of the space-vehicles contained in the message */
 	enum gnss_system system;
 	/** Number of GSV messages in total */
@@ -154,8 +199,8 @@ struct gnss_nmea0183_gsv_header {
  * @retval 0 if successful
  * @retval -EINVAL if input is invalid
  */
-int gnss_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
-				   struct gnss_nmea0183_gsv_header *header);
+int lx6_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
+				  struct lx6_nmea0183_gsv_header *header);
 
 /**
  * @brief Parses space-vehicles in NMEA0183 GSV message
@@ -172,7 +217,82 @@ int gnss_nmea0183_parse_gsv_header(const char **argv, uint16_t argc,
  * @retval -ENOMEM if all space-vehicles in message could not be stored at destination
  * @retval -EINVAL if input is invalid
  */
-int gnss_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_satellite *satellites,
-				uint16_t size);
+int lx6_nmea0183_parse_gsv_svs(const char **argv, uint16_t argc, struct gnss_satellite *satellites,
+			       uint16_t size);
+
+/** Maximum number of space-vehicles in a NMEA0183 GSA message */
+#define LX6_NMEA0183_GSA_SVS_MAX (12)
+
+/** Dilution of precision structure, in thousandths */
+struct lx6_nmea0183_dop {
+	/** Position dilution of precision */
+	uint32_t pdop;
+	/** Horizontal dilution of precision */
+	uint32_t hdop;
+	/** Vertical dilution of precision */
+	uint32_t vdop;
+};
+
+/** Space-vehicle used for fix */
+struct lx6_nmea0183_gsa_sv {
+	/** System of space-vehicle */
+	enum gnss_system system;
+	/** PRN of space-vehicle, aligned with the PRN of GSV parsed satellites */
+	uint16_t prn;
+};
+
+/** GSA message structure */
+struct lx6_nmea0183_gsa {
+	/** Dilution of precision of fix */
+	struct lx6_nmea0183_dop dop;
+	/** Space-vehicles used for fix */
+	struct lx6_nmea0183_gsa_sv svs[LX6_NMEA0183_GSA_SVS_MAX];
+	/** Number of space-vehicles used for fix */
+	uint8_t svs_size;
+};
+
+/**
+ * @brief Parses NMEA0183 GSA message
+ *
+ * @details Parses the dilutions of precision and the space-vehicles used for fix
+ * from the NMEA0183 GSA message provided as an array of strings split by ','.
+ * The system of the space-vehicles is derived from the talker, from the system
+ * id field if present, or from the PRN range for the combined "GN" talker.
+ * Space-vehicles of unknown systems are skipped.
+ *
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param gsa Destination for data parsed from NMEA0183 GSA message
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if input is invalid
+ */
+int lx6_nmea0183_parse_gsa(const char **argv, uint16_t argc, struct lx6_nmea0183_gsa *gsa);
+
+/** GST message structure, standard deviations in millimeters */
+struct lx6_nmea0183_gst {
+	/** Standard deviation of latitude error */
+	uint32_t latitude_stddev;
+	/** Standard deviation of longitude error */
+	uint32_t longitude_stddev;
+	/** Standard deviation of altitude error */
+	uint32_t altitude_stddev;
+};
+
+/**
+ * @brief Parses NMEA0183 GST message
+ *
+ * @details Parses the standard deviations of the position errors from the
+ * NMEA0183 GST message provided as an array of strings split by ','
+ *
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param gst Destination for data parsed from NMEA0183 GST message
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if GNSS has no fix
+ * @retval -EINVAL if input is invalid
+ */
+int lx6_nmea0183_parse_gst(const char **argv, uint16_t argc, struct lx6_nmea0183_gst *gst);
 
-#endif /* ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_H_ */
+#endif /* ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_H_ */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include "gnss_nmea0183_framer.h"
+
+#define LX6_NMEA0183_FRAMER_MESSAGE_ID_SIZE_MIN (6)
+#define LX6_NMEA0183_FRAMER_CHECKSUM_DIGITS     (2)
+
+enum lx6_nmea0183_framer_state {
+	/* Waiting for the '$' starting a sentence */
+	LX6_NMEA0183_FRAMER_STATE_IDLE = 0,
+	/* Receiving fields covered by the checksum */
+	LX6_NMEA0183_FRAMER_STATE_FIELDS,
+	/* Receiving the checksum digits following '*' */
+	LX6_NMEA0183_FRAMER_STATE_CHECKSUM,
+	/* Waiting for the end of line following the checksum */
+	LX6_NMEA0183_FRAMER_STATE_END,
+};
+
+static void lx6_nmea0183_framer_start(struct lx6_nmea0183_framer *framer, uint32_t timestamp)
+{
+	framer->buf[0] = '$';
+	framer->timestamp = timestamp;
+	framer->pos = 1;
+	framer->argv[0] = framer->buf;
+	framer->argc = 1;
+	framer->checksum = 0;
+	framer->expected_checksum = 0;
+	framer->checksum_digits = 0;
+	framer->state = LX6_NMEA0183_FRAMER_STATE_FIELDS;
+}
+
+static void lx6_nmea0183_framer_drop(struct lx6_nmea0183_framer *framer)
+{
+	framer->stats.framing_errors++;
+	framer->state = LX6_NMEA0183_FRAMER_STATE_IDLE;
+}
+
+static bool lx6_nmea0183_framer_put(struct lx6_nmea0183_framer *framer, char c)
+{
+	/* Keep room for the null terminator of the last field */
+	if (framer->pos >= (framer->buf_size - 1)) {
+		lx6_nmea0183_framer_drop(framer);
+		return false;
+	}
+
+	framer->buf[framer->pos++] = c;
+	return true;
+}
+
+static bool lx6_nmea0183_framer_next_field(struct lx6_nmea0183_framer *framer)
+{
+	if (framer->argc == framer->argv_size) {
+		lx6_nmea0183_framer_drop(framer);
+		return false;
+	}
+
+	if (!lx6_nmea0183_framer_put(framer, '\0')) {
+		return false;
+	}
+
+	framer->argv[framer->argc++] = &framer->buf[framer->pos];
+	return true;
+}
+
+static int lx6_nmea0183_framer_hex_digit(char c)
+{
+	if ((c >= '0') && (c <= '9')) {
+		return c - '0';
+	}
+
+	if ((c >= 'A') && (c <= 'F')) {
+		return c - 'A' + 10;
+	}
+
+	if ((c >= 'a') && (c <= 'f')) {
+		return c - 'a' + 10;
+	}
+
+	return -EINVAL;
+}
+
+static void lx6_nmea0183_framer_complete(struct lx6_nmea0183_framer *framer)
+{
+	struct lx6_nmea0183_sentence sentence;
+
+	framer->state = LX6_NMEA0183_FRAMER_STATE_IDLE;
+	framer->buf[framer->pos] = '\0';
+
+	if (framer->checksum != framer->expected_checksum) {
+		framer->stats.checksum_errors++;
+		return;
+	}
+
+	/* Message id must at least contain '$', talker and sentence type */
+	if ((framer->argv[1] - framer->argv[0]) <= LX6_NMEA0183_FRAMER_MESSAGE_ID_SIZE_MIN) {
+		framer->stats.framing_errors++;
+		return;
+	}
+
+	sentence.talker = &framer->buf[1];
+	sentence.type = &framer->buf[3];
+	sentence.argv = framer->argv;
+	sentence.argc = framer->argc;
+	sentence.timestamp = framer->timestamp;
+
+	framer->stats.sentences++;
+	framer->callback(&sentence, framer->user_data);
+}
+
+static void lx6_nmea0183_framer_process_byte(struct lx6_nmea0183_framer *framer, char c,
+					     uint32_t timestamp)
+{
+	int digit;
+
+	/* A start of sentence always resynchronizes the framer */
+	if (c == '$') {
+		if (framer->state != LX6_NMEA0183_FRAMER_STATE_IDLE) {
+			framer->stats.framing_errors++;
+		}
+
+		lx6_nmea0183_framer_start(framer, timestamp);
+		return;
+	}
+
+	switch (framer->state) {
+	case LX6_NMEA0183_FRAMER_STATE_IDLE:
+		break;
+
+	case LX6_NMEA0183_FRAMER_STATE_FIELDS:
+		if (c == '*') {
+			if (lx6_nmea0183_framer_next_field(framer)) {
+				framer->state = LX6_NMEA0183_FRAMER_STATE_CHECKSUM;
+			}
+
+			break;
+		}
+
+		/* Sentences without checksum are not supported */
+		if ((c == '\r') || (c == '\n')) {
+			lx6_nmea0183_framer_drop(framer);
+			break;
+		}
+
+		framer->checksum ^= (uint8_t)c;
+
+		if (c == ',') {
+			lx6_nmea0183_framer_next_field(framer);
+			break;
+		}
+
+		lx6_nmea0183_framer_put(framer, c);
+		break;
+
+	case LX6_NMEA0183_FRAMER_STATE_CHECKSUM:
+		digit = lx6_nmea0183_framer_hex_digit(c);
+		if (digit < 0) {
+			lx6_nmea0183_framer_drop(framer);
+			break;
+		}
+
+		if (!lx6_nmea0183_framer_put(framer, c)) {
+			break;
+		}
+
+		framer->expected_checksum = (framer->expected_checksum << 4) | (uint8_t)digit;
+		framer->checksum_digits++;
+
+		if (framer->checksum_digits == LX6_NMEA0183_FRAMER_CHECKSUM_DIGITS) {
+			framer->state = LX6_NMEA0183_FRAMER_STATE_END;
+		}
+
+		break;
+
+	case LX6_NMEA0183_FRAMER_STATE_END:
+		if ((c == '\r') || (c == '\n')) {
+			lx6_nmea0183_framer_complete(framer);
+			break;
+		}
+
+		lx6_nmea0183_framer_drop(framer);
+		break;
+
+	default:
+		framer->state = LX6_NMEA0183_FRAMER_STATE_IDLE;
+		break;
+	}
+}
+
+int lx6_nmea0183_framer_init(struct lx6_nmea0183_framer *framer,
+			     const struct lx6_nmea0183_framer_config *config)
+{
+	__ASSERT(framer != NULL, "framer argument must be provided");
+	__ASSERT(config != NULL, "config argument must be provided");
+
+	if ((config->buf == NULL) || (config->buf_size < LX6_NMEA0183_FRAMER_MESSAGE_ID_SIZE_MIN) ||
+	    (config->argv == NULL) || (config->argv_size < 2) || (config->callback == NULL)) {
+		return -EINVAL;
+	}
+
+	memset(framer, 0, sizeof(struct lx6_nmea0183_framer));
+	framer->buf = config->buf;
+	framer->buf_size = config->buf_size;
+	framer->argv = config->argv;
+	framer->argv_size = config->argv_size;
+	framer->callback = config->callback;
+	framer->user_data = config->user_data;
+	return 0;
+}
+
+void lx6_nmea0183_framer_reset(struct lx6_nmea0183_framer *framer)
+{
+	framer->state = LX6_NMEA0183_FRAMER_STATE_IDLE;
+}
+
+void lx6_nmea0183_framer_receive(struct lx6_nmea0183_framer *framer, const uint8_t *bytes,
+				 size_t size, uint32_t timestamp)
+{
+	__ASSERT(framer != NULL, "framer argument must be provided");
+	__ASSERT(bytes != NULL, "bytes argument must be provided");
+
+	for (size_t i = 0; i < size; i++) {
+		lx6_nmea0183_framer_process_byte(framer, (char)bytes[i], timestamp);
+	}
+}
+
+void lx6_nmea0183_framer_get_stats(const struct lx6_nmea0183_framer *framer,
+				   struct lx6_nmea0183_framer_stats *stats)
+{
+	*stats = framer->stats;
+}
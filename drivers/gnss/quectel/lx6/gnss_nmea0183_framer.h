@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The GNSS NMEA0183 framer delimits NMEA0183 sentences from a raw byte stream,
+ * typically read straight from a modem_pipe, without going through modem_chat.
+ *
+ * Each byte is inspected exactly once: the checksum is accumulated and the field
+ * separators are replaced by null terminators as bytes arrive. Once the checksum
+ * of a sentence is verified, a sentence view pointing into the framer buffer is
+ * handed to the callback. The view carries an argv compatible with the one
+ * produced by modem_chat, so the GNSS NMEA0183 match callbacks can be used as is.
+ * Corrupted, truncated or overlong sentences are dropped without being parsed.
+ *
+ *   static void my_callback(const struct lx6_nmea0183_sentence *sentence,
+ *                           void *user_data)
+ *   {
+ *           ...
+ *   }
+ *
+ *   const struct lx6_nmea0183_framer_config config = {
+ *           .buf = my_buf,
+ *           .buf_size = sizeof(my_buf),
+ *           .argv = my_argv,
+ *           .argv_size = ARRAY_SIZE(my_argv),
+ *           .callback = my_callback,
+ *           .user_data = my_data,
+ *   };
+ *
+ *   lx6_nmea0183_framer_init(&my_framer, &config);
+ *   ...
+ *   lx6_nmea0183_framer_receive(&my_framer, bytes, size, k_cycle_get_32());
+ */
+
+#ifndef ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_FRAMER_H_
+#define ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_FRAMER_H_
+
+#include <zephyr/types.h>
+
+/** Zero-copy view of a validated NMEA0183 sentence */
+struct lx6_nmea0183_sentence {
+	/** Talker identifier, 2 characters which are not null terminated */
+	const char *talker;
+	/** Sentence type, 3 characters which are not null terminated */
+	const char *type;
+	/** Null terminated fields including message id and checksum */
+	char **argv;
+	/** Number of fields in argv */
+	uint16_t argc;
+	/** Cycle count at which the first byte of the sentence was received */
+	uint32_t timestamp;
+};
+
+/**
+ * @brief Callback invoked for every sentence with a valid checksum
+ *
+ * @note The sentence view is only valid for the duration of the callback.
+ */
+typedef void (*lx6_nmea0183_framer_callback)(const struct lx6_nmea0183_sentence *sentence,
+					     void *user_data);
+
+/** GNSS NMEA0183 framer statistics */
+struct lx6_nmea0183_framer_stats {
+	/** Number of sentences passed to the callback */
+	uint32_t sentences;
+	/** Number of sentences dropped due to a checksum mismatch */
+	uint32_t checksum_errors;
+	/** Number of sentences dropped due to a framing error or lack of space */
+	uint32_t framing_errors;
+};
+
+struct lx6_nmea0183_framer {
+	char *buf;
+	uint16_t buf_size;
+	char **argv;
+	uint16_t argv_size;
+	lx6_nmea0183_framer_callback callback;
+	void *user_data;
+	struct lx6_nmea0183_framer_stats stats;
+	uint16_t pos;
+	uint16_t argc;
+	uint32_t timestamp;
+	uint8_t checksum;
+	uint8_t expected_checksum;
+	uint8_t checksum_digits;
+	uint8_t state;
+};
+
+/** GNSS NMEA0183 framer configuration structure */
+struct lx6_nmea0183_framer_config {
+	/** Buffer in which the sentence being received is stored */
+	char *buf;
+	/** Size of buffer, must fit the longest sentence and its null terminator */
+	uint16_t buf_size;
+	/** Buffer for the fields of the sentence being received */
+	char **argv;
+	/** Number of elements in buffer for fields */
+	uint16_t argv_size;
+	/** Callback invoked for every sentence with a valid checksum */
+	lx6_nmea0183_framer_callback callback;
+	/** User data passed to callback */
+	void *user_data;
+};
+
+/**
+ * @brief Initialize a GNSS NMEA0183 framer instance
+ *
+ * @param framer GNSS NMEA0183 framer instance to initialize
+ * @param config Configuration to apply to GNSS NMEA0183 framer instance
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if configuration is invalid
+ */
+int lx6_nmea0183_framer_init(struct lx6_nmea0183_framer *framer,
+			     const struct lx6_nmea0183_framer_config *config);
+
+/**
+ * @brief Drop any partially received sentence
+ *
+ * @param framer GNSS NMEA0183 framer instance
+ */
+void lx6_nmea0183_framer_reset(struct lx6_nmea0183_framer *framer);
+
+/**
+ * @brief Feed received bytes to the framer
+ *
+ * @details The callback is invoked from this function for every sentence which
+ * is completed and valid.
+ *
+ * @param framer GNSS NMEA0183 framer instance
+ * @param bytes Received bytes
+ * @param size Number of received bytes
+ * @param timestamp Cycle count at which the bytes were received
+ */
+void lx6_nmea0183_framer_receive(struct lx6_nmea0183_framer *framer, const uint8_t *bytes,
+				 size_t size, uint32_t timestamp);
+
+/**
+ * @brief Get statistics of the framer
+ *
+ * @param framer GNSS NMEA0183 framer instance
+ * @param stats Destination for statistics
+ */
+void lx6_nmea0183_framer_get_stats(const struct lx6_nmea0183_framer *framer,
+				   struct lx6_nmea0183_framer_stats *stats);
+
+#endif /* ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_FRAMER_H_ */
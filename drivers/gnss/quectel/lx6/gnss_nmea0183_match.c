@@ -7,6 +7,9 @@
 #include <zephyr/drivers/gnss/gnss_publish.h>
 #include <zephyr/kernel.h>
 #include <zephyr/modem/chat.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/math_extras.h>
 
 #include <string.h>
 
@@ -14,11 +17,67 @@
 #include "gnss_nmea0183.h"
 #include "gnss_nmea0183_match.h"
 
-static int gnss_nmea0183_match_parse_utc(char **argv, uint16_t argc, uint32_t *utc)
+#define LX6_NMEA0183_MATCH_MESSAGE_ID_SIZE (6)
+#define LX6_NMEA0183_MATCH_TYPE_MASK       (BIT(15) - 1)
+
+/* Pack 3 letters of a sentence type, 5 bits each */
+#define LX6_NMEA0183_MATCH_TYPE(a, b, c) ((((a) - '@') << 10) | (((b) - '@') << 5) | ((c) - '@'))
+
+/*
+ * Multiplicative hash of a sentence type into the dispatch table, the multiplier
+ * is chosen to be collision free for all supported sentence types.
+ */
+#define LX6_NMEA0183_MATCH_HASH_MULTIPLIER (264U)
+#define LX6_NMEA0183_MATCH_HASH_SHIFT      (10U)
+#define LX6_NMEA0183_MATCH_TABLE_SIZE      (16U)
+#define LX6_NMEA0183_MATCH_SLOT(type)                                                              \
+	((((uint32_t)(type) * LX6_NMEA0183_MATCH_HASH_MULTIPLIER) >>                               \
+	  LX6_NMEA0183_MATCH_HASH_SHIFT) &                                                         \
+	 (LX6_NMEA0183_MATCH_TABLE_SIZE - 1))
+
+#define LX6_NMEA0183_MATCH_TYPE_GGA LX6_NMEA0183_MATCH_TYPE('G', 'G', 'A')
+#define LX6_NMEA0183_MATCH_TYPE_RMC LX6_NMEA0183_MATCH_TYPE('R', 'M', 'C')
+#define LX6_NMEA0183_MATCH_TYPE_GSV LX6_NMEA0183_MATCH_TYPE('G', 'S', 'V')
+#define LX6_NMEA0183_MATCH_TYPE_GSA LX6_NMEA0183_MATCH_TYPE('G', 'S', 'A')
+#define LX6_NMEA0183_MATCH_TYPE_GLL LX6_NMEA0183_MATCH_TYPE('G', 'L', 'L')
+#define LX6_NMEA0183_MATCH_TYPE_VTG LX6_NMEA0183_MATCH_TYPE('V', 'T', 'G')
+#define LX6_NMEA0183_MATCH_TYPE_ZDA LX6_NMEA0183_MATCH_TYPE('Z', 'D', 'A')
+#define LX6_NMEA0183_MATCH_TYPE_GST LX6_NMEA0183_MATCH_TYPE('G', 'S', 'T')
+
+#define LX6_NMEA0183_MATCH_SLOT_BIT(type) BIT(LX6_NMEA0183_MATCH_SLOT(type))
+
+BUILD_ASSERT(POPCOUNT(LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_GGA) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_RMC) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_GSV) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_GSA) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_GLL) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_VTG) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_ZDA) |
+		      LX6_NMEA0183_MATCH_SLOT_BIT(LX6_NMEA0183_MATCH_TYPE_GST)) == 8,
+	     "Sentence types must not collide in dispatch table");
+
+/* Sentences output after VTG within an epoch, VTG being the only sentence without time */
+#define LX6_NMEA0183_MATCH_SENTENCES_AFTER_VTG                                                     \
+	(LX6_NMEA0183_MATCH_SENTENCE_GGA | LX6_NMEA0183_MATCH_SENTENCE_GLL)
+
+#define LX6_NMEA0183_MATCH_HANDLER(_type, _callback)                                               \
+	[LX6_NMEA0183_MATCH_SLOT(_type)] = {.type = (_type), .callback = (_callback)}
+
+struct lx6_nmea0183_match_handler {
+	uint16_t type;
+	modem_chat_match_callback callback;
+};
+
+static int lx6_nmea0183_match_parse_utc(const char *hhmmss, uint32_t *utc)
 {
 	int64_t i64;
 
-	if ((gnss_parse_dec_to_milli(argv[1], &i64) < 0) || (i64 < 0) || (i64 > UINT32_MAX)) {
+	/* Time is left empty until the receiver knows it, which is not midnight */
+	if (hhmmss[0] == '\0') {
+		return -EINVAL;
+	}
+
+	if ((lx6_parse_dec_to_milli(hhmmss, &i64) < 0) || (i64 < 0) || (i64 > UINT32_MAX)) {
 		return -EINVAL;
 	}
 
@@ -26,108 +85,1118 @@ static int gnss_nmea0183_match_parse_utc(char **argv, uint16_t argc, uint32_t *u
 	return 0;
 }
 
+static inline uint8_t lx6_nmea0183_match_system_index(enum gnss_system system)
+{
+	return (uint8_t)u32_count_trailing_zeros((uint32_t)system);
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+#define LX6_NMEA0183_MATCH_SAT_TABLE_SIZE (CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE_SIZE)
+#define LX6_NMEA0183_MATCH_SAT_TABLE_MASK (LX6_NMEA0183_MATCH_SAT_TABLE_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(LX6_NMEA0183_MATCH_SAT_TABLE_SIZE),
+	     "Satellite table size must be a power of two");
+
+/* Entry holds a satellite */
+#define LX6_NMEA0183_MATCH_SAT_FLAG_USED     BIT(0)
+/* Satellite is part of the sky view being processed */
+#define LX6_NMEA0183_MATCH_SAT_FLAG_REPORTED BIT(1)
+/* Satellite must be notified */
+#define LX6_NMEA0183_MATCH_SAT_FLAG_DIRTY    BIT(2)
+/* Satellite has never been notified */
+#define LX6_NMEA0183_MATCH_SAT_FLAG_ADDED    BIT(3)
+
+static inline uint32_t lx6_nmea0183_match_sat_key(const struct gnss_satellite *satellite)
+{
+	return ((uint32_t)satellite->system << 16) | satellite->prn;
+}
+
+static inline uint16_t lx6_nmea0183_match_sat_home(uint32_t key)
+{
+	/* Fibonacci hashing spreads PRNs of a system, which are consecutive */
+	return (uint16_t)((key * 2654435761U) >> 16) & LX6_NMEA0183_MATCH_SAT_TABLE_MASK;
+}
+
+/* Find entry of satellite, or the free entry in which it must be inserted */
+static struct lx6_nmea0183_match_sat_entry *
+lx6_nmea0183_match_sat_find(struct lx6_nmea0183_match_data *data,
+			    const struct gnss_satellite *satellite)
+{
+	uint32_t key = lx6_nmea0183_match_sat_key(satellite);
+	uint16_t slot = lx6_nmea0183_match_sat_home(key);
+	struct lx6_nmea0183_match_sat_entry *entry;
+
+	for (uint16_t i = 0; i < LX6_NMEA0183_MATCH_SAT_TABLE_SIZE; i++) {
+		entry = &data->sat_table[slot];
+
+		if (((entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_USED) == 0) ||
+		    (lx6_nmea0183_match_sat_key(&entry->satellite) == key)) {
+			return entry;
+		}
+
+		slot = (slot + 1) & LX6_NMEA0183_MATCH_SAT_TABLE_MASK;
+	}
+
+	return NULL;
+}
+
+/* Remove entry, shifting back following entries so that no tombstone is needed */
+static void lx6_nmea0183_match_sat_remove(struct lx6_nmea0183_match_data *data,
+					  struct lx6_nmea0183_match_sat_entry *entry)
+{
+	uint16_t hole = (uint16_t)(entry - data->sat_table);
+	uint16_t slot = hole;
+	uint16_t home;
+
+	/* Hole is freed first so that probing stops there in a full table */
+	entry->flags = 0;
+
+	while (true) {
+		slot = (slot + 1) & LX6_NMEA0183_MATCH_SAT_TABLE_MASK;
+		entry = &data->sat_table[slot];
+
+		if ((entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_USED) == 0) {
+			break;
+		}
+
+		/* Entry may only move to hole if hole lies between its home and its slot */
+		home = lx6_nmea0183_match_sat_home(lx6_nmea0183_match_sat_key(&entry->satellite));
+		if (((slot - home) & LX6_NMEA0183_MATCH_SAT_TABLE_MASK) >=
+		    ((slot - hole) & LX6_NMEA0183_MATCH_SAT_TABLE_MASK)) {
+			data->sat_table[hole] = *entry;
+			entry->flags = 0;
+			hole = slot;
+		}
+	}
+}
+
+static bool lx6_nmea0183_match_sat_exceeds(uint16_t a, uint16_t b, uint8_t hysteresis)
+{
+	uint16_t diff = (a > b) ? (a - b) : (b - a);
+
+	return diff >= MAX(hysteresis, 1);
+}
+
+static bool lx6_nmea0183_match_sat_changed(struct lx6_nmea0183_match_data *data,
+					   const struct gnss_satellite *notified,
+					   const struct gnss_satellite *reported)
+{
+	return (notified->is_tracked != reported->is_tracked) ||
+	       lx6_nmea0183_match_sat_exceeds(notified->snr, reported->snr,
+					      data->sat_snr_hysteresis) ||
+	       lx6_nmea0183_match_sat_exceeds(notified->elevation, reported->elevation,
+					      data->sat_elevation_hysteresis);
+}
+
+/* Merge reported satellites into the satellite table */
+static void lx6_nmea0183_match_sat_report(struct lx6_nmea0183_match_data *data,
+					  const struct gnss_satellite *satellites, uint16_t size)
+{
+	const struct gnss_satellite *satellite;
+	struct lx6_nmea0183_match_sat_entry *entry;
+
+	for (uint16_t i = 0; i < size; i++) {
+		satellite = &satellites[i];
+
+		/* Satellites which don't fit in a full table are ignored */
+		entry = lx6_nmea0183_match_sat_find(data, satellite);
+		if (entry == NULL) {
+			continue;
+		}
+
+		if ((entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_USED) == 0) {
+			entry->satellite = *satellite;
+			entry->flags = LX6_NMEA0183_MATCH_SAT_FLAG_USED |
+				       LX6_NMEA0183_MATCH_SAT_FLAG_DIRTY |
+				       LX6_NMEA0183_MATCH_SAT_FLAG_ADDED;
+		} else if (lx6_nmea0183_match_sat_changed(data, &entry->satellite, satellite)) {
+			entry->satellite = *satellite;
+			entry->flags |= LX6_NMEA0183_MATCH_SAT_FLAG_DIRTY;
+		}
+
+		entry->flags |= LX6_NMEA0183_MATCH_SAT_FLAG_REPORTED;
+		entry->age = 0;
+	}
+}
+
+/* Age satellites missing from the sky view and notify changed satellites */
+static void lx6_nmea0183_match_sat_commit(struct lx6_nmea0183_match_data *data)
+{
+	struct lx6_nmea0183_match_sat_entry *entry;
+	struct lx6_nmea0183_match_sat_delta *delta;
+	uint16_t size = 0;
+
+	for (uint16_t slot = 0; slot < LX6_NMEA0183_MATCH_SAT_TABLE_SIZE; slot++) {
+		entry = &data->sat_table[slot];
+		delta = &data->sat_deltas[size];
+
+		if ((entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_USED) == 0) {
+			continue;
+		}
+
+		if (entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_REPORTED) {
+			if (entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_DIRTY) {
+				delta->satellite = entry->satellite;
+				delta->change = (entry->flags & LX6_NMEA0183_MATCH_SAT_FLAG_ADDED)
+							? LX6_NMEA0183_MATCH_SAT_ADDED
+							: LX6_NMEA0183_MATCH_SAT_CHANGED;
+				size++;
+			}
+
+			entry->flags = LX6_NMEA0183_MATCH_SAT_FLAG_USED;
+			continue;
+		}
+
+		if (entry->age < data->sat_max_age) {
+			entry->age++;
+			continue;
+		}
+
+		delta->satellite = entry->satellite;
+		delta->change = LX6_NMEA0183_MATCH_SAT_REMOVED;
+		size++;
+	}
+
+	/* Removal shifts entries back, so it is deferred until the table has been scanned */
+	for (uint16_t i = 0; i < size; i++) {
+		delta = &data->sat_deltas[i];
+
+		if (delta->change == LX6_NMEA0183_MATCH_SAT_REMOVED) {
+			entry = lx6_nmea0183_match_sat_find(data, &delta->satellite);
+			lx6_nmea0183_match_sat_remove(data, entry);
+		}
+	}
+
+	if ((size > 0) && (data->sat_delta_callback != NULL)) {
+		data->sat_delta_callback(data->gnss, data->sat_deltas, size);
+	}
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+static void lx6_nmea0183_match_sky_stream(struct lx6_nmea0183_match_data *data,
+					  const struct gnss_satellite *satellites, uint16_t size,
+					  uint8_t flags)
+{
+	struct lx6_nmea0183_match_sky *sky = &data->sky;
+
+	if (!sky->streaming) {
+		flags |= LX6_NMEA0183_MATCH_SAT_STREAM_START;
+	}
+
+	sky->streaming = (flags & LX6_NMEA0183_MATCH_SAT_STREAM_END) == 0;
+
+	if (data->sat_stream_callback != NULL) {
+		data->sat_stream_callback(data->gnss, satellites, size, flags);
+	}
+}
+#endif
+
 #if CONFIG_GNSS_SATELLITES
-static void gnss_nmea0183_match_reset_gsv(struct gnss_nmea0183_match_data *data)
+/* UTC of the epoch the satellites being received belong to, following its sentences */
+static uint32_t lx6_nmea0183_match_sky_utc(struct lx6_nmea0183_match_data *data)
+{
+	return data->epoch.open ? data->epoch.utc : data->epoch.last_utc;
+}
+
+/* Sky view is published once per epoch, or once per cycle until the time is known */
+static bool lx6_nmea0183_match_sky_publishable(struct lx6_nmea0183_match_data *data)
+{
+	struct lx6_nmea0183_match_sky *sky = &data->sky;
+	uint32_t utc = lx6_nmea0183_match_sky_utc(data);
+
+	return !sky->published &&
+	       ((utc == LX6_NMEA0183_MATCH_UTC_NONE) || (utc != sky->published_utc));
+}
+
+#if !CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+/* Remove the satellites of an incomplete sequence, which would leave the sky view partial */
+static void lx6_nmea0183_match_sky_discard(struct lx6_nmea0183_match_data *data,
+					   enum gnss_system system, uint16_t first)
+{
+	uint16_t length = first;
+
+	for (uint16_t i = first; i < data->satellites_length; i++) {
+		if (data->satellites[i].system != system) {
+			data->satellites[length++] = data->satellites[i];
+		}
+	}
+
+	data->satellites_length = length;
+}
+#endif
+
+static void lx6_nmea0183_match_sky_publish(struct lx6_nmea0183_match_data *data)
+{
+	struct lx6_nmea0183_match_sky *sky = &data->sky;
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	/* Satellites have already been streamed, only the end of the sky view is left */
+	if (sky->streaming) {
+		lx6_nmea0183_match_sky_stream(data, NULL, 0, LX6_NMEA0183_MATCH_SAT_STREAM_END);
+	}
+#else
+	gnss_publish_satellites(data->gnss, data->satellites, data->satellites_length);
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	lx6_nmea0183_match_sat_report(data, data->satellites, data->satellites_length);
+#endif
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	lx6_nmea0183_match_sat_commit(data);
+#endif
+	sky->published_utc = lx6_nmea0183_match_sky_utc(data);
+	sky->published = true;
+}
+
+/* Close the sky view, publishing it unless one has already been published for the epoch */
+static void lx6_nmea0183_match_sky_flush(struct lx6_nmea0183_match_data *data)
 {
+	struct lx6_nmea0183_match_sky *sky = &data->sky;
+
+	if ((sky->completed != 0) && lx6_nmea0183_match_sky_publishable(data)) {
+		lx6_nmea0183_match_sky_publish(data);
+	}
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	/* Satellites of incomplete sequences may have been streamed already */
+	if (sky->streaming) {
+		lx6_nmea0183_match_sky_stream(data, NULL, 0, LX6_NMEA0183_MATCH_SAT_STREAM_END);
+	}
+#endif
+
+	if (sky->started != 0) {
+		sky->expected = sky->completed;
+	}
+
+	memset(sky->message_number, 0, sizeof(sky->message_number));
+	sky->started = 0;
+	sky->completed = 0;
+	sky->published = false;
 	data->satellites_length = 0;
-	data->gsv_message_number = 1;
 }
+
+static void lx6_nmea0183_match_sky_timeout_handler(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct lx6_nmea0183_match_sky *sky =
+		CONTAINER_OF(dwork, struct lx6_nmea0183_match_sky, timeout_work);
+	struct lx6_nmea0183_match_data *data =
+		CONTAINER_OF(sky, struct lx6_nmea0183_match_data, sky);
+
+	lx6_nmea0183_match_sky_flush(data);
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+static bool lx6_nmea0183_match_is_accurate(struct lx6_nmea0183_match_data *data)
+{
+	uint64_t horizontal_variance;
+	uint64_t gate_variance;
+
+	/* Loss of fix is always published, no statistics are output without fix */
+	if ((data->accuracy_gate == 0) ||
+	    (data->data.info.fix_status == GNSS_FIX_STATUS_NO_FIX)) {
+		return true;
+	}
+
+	if (!data->gst_valid) {
+		return false;
+	}
+
+	horizontal_variance = ((uint64_t)data->gst.latitude_stddev * data->gst.latitude_stddev) +
+			      ((uint64_t)data->gst.longitude_stddev * data->gst.longitude_stddev);
+	gate_variance = (uint64_t)data->accuracy_gate * data->accuracy_gate;
+	return horizontal_variance <= gate_variance;
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+static void lx6_nmea0183_match_record_latency(struct lx6_nmea0183_match_latency *latency,
+					      uint32_t start_cycles, uint32_t end_cycles)
+{
+	uint32_t us = k_cyc_to_us_floor32(end_cycles - start_cycles);
+	uint8_t bucket;
+
+	/* Bucket n holds latencies within [2^n, 2^(n+1)) microseconds */
+	bucket = (uint8_t)(31 - u32_count_leading_zeros(us | 1));
+	bucket = MIN(bucket, LX6_NMEA0183_MATCH_LATENCY_BUCKETS - 1);
+
+	latency->min_us = (latency->count == 0) ? us : MIN(latency->min_us, us);
+	latency->max_us = MAX(latency->max_us, us);
+	latency->total_us += us;
+	latency->count++;
+	latency->histogram[bucket]++;
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_LATEST_FIX
+/*
+ * The sequence is odd while a buffer is being written. Once even, the latest
+ * snapshot is held by buffer (sequence / 2) % 2, which is left untouched by the
+ * writer until the sequence has been incremented by 3.
+ */
+static void lx6_nmea0183_match_store_latest(struct lx6_nmea0183_match_data *data)
+{
+	atomic_val_t seq = atomic_get(&data->latest_seq);
+	uint8_t next = (uint8_t)(((seq >> 1) + 1) & 1);
+
+	atomic_set(&data->latest_seq, seq + 1);
+	barrier_dmem_fence_full();
+	data->latest[next] = data->data;
+	barrier_dmem_fence_full();
+	atomic_set(&data->latest_seq, seq + 2);
+}
+#endif
+
+int lx6_nmea0183_match_get_latest(struct lx6_nmea0183_match_data *data, struct gnss_data *latest)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_LATEST_FIX
+	atomic_val_t seq;
+	atomic_val_t end;
+
+	do {
+		seq = atomic_get(&data->latest_seq) & ~1;
+		if (seq == 0) {
+			return -ENODATA;
+		}
+
+		*latest = data->latest[(seq >> 1) & 1];
+		barrier_dmem_fence_full();
+		end = atomic_get(&data->latest_seq);
+	} while ((end - seq) > 2);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static void lx6_nmea0183_match_epoch_count(struct lx6_nmea0183_match_data *data, uint32_t *counter)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	(*counter)++;
+	k_spin_unlock(&data->lock, key);
+}
+
+static void lx6_nmea0183_match_epoch_publish(struct lx6_nmea0183_match_data *data)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+	struct lx6_nmea0183_match_epoch *epoch = &data->epoch;
+	k_spinlock_key_t key;
+	uint32_t publish_cycles;
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	/* First fixes are timed as output by the receiver, whether gated or not */
+	if (data->fix_callback != NULL) {
+		data->fix_callback(data->gnss, &data->data);
+	}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	if (!lx6_nmea0183_match_is_accurate(data)) {
+		lx6_nmea0183_match_epoch_count(data, &data->epoch_stats.gated);
+		return;
+	}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+	publish_cycles = k_cycle_get_32();
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_LATEST_FIX
+	lx6_nmea0183_match_store_latest(data);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	if (data->history != NULL) {
+		gnss_history_push_data(data->history, &data->data);
+	}
+#endif
+
+	gnss_publish_data(data->gnss, &data->data);
+
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	if (data->data_callback != NULL) {
+		data->data_callback(data->gnss, &data->data);
+	}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+	key = k_spin_lock(&data->lock);
+	lx6_nmea0183_match_record_latency(&data->epoch_stats.assembly, epoch->first_cycles,
+					  epoch->complete_cycles);
+	lx6_nmea0183_match_record_latency(&data->epoch_stats.publish, epoch->first_cycles,
+					  publish_cycles);
+	k_spin_unlock(&data->lock, key);
+#endif
+}
+
+/*
+ * Sentences which must be received for the epoch to be complete. Decimated
+ * sentences are missing from most epochs and thus not awaited, unless all
+ * required sentences are decimated.
+ */
+static uint8_t lx6_nmea0183_match_epoch_required(const struct lx6_nmea0183_match_data *data)
+{
+	uint8_t required = data->epoch_required & ~data->epoch_decimated;
+
+	return (required != 0) ? required : data->epoch_required;
+}
+
+static void lx6_nmea0183_match_epoch_close(struct lx6_nmea0183_match_data *data)
+{
+	struct lx6_nmea0183_match_epoch *epoch = &data->epoch;
+	uint8_t required = lx6_nmea0183_match_epoch_required(data);
+
+	if (!epoch->open) {
+		return;
+	}
+
+	(void)k_work_cancel_delayable(&epoch->timeout_work);
+	epoch->open = false;
+	epoch->last_utc = epoch->utc;
+	epoch->complete_cycles = k_cycle_get_32();
+
+	if ((epoch->received & required) == required) {
+		lx6_nmea0183_match_epoch_count(data, &data->epoch_stats.complete);
+		lx6_nmea0183_match_epoch_publish(data);
+		return;
+	}
+
+	/* Incomplete epoch, published only if some of its required sentences were received */
+	if ((data->epoch_policy == LX6_NMEA0183_MATCH_EPOCH_PUBLISH_PARTIAL) &&
+	    ((epoch->received & required) != 0)) {
+		lx6_nmea0183_match_epoch_count(data, &data->epoch_stats.partial);
+		lx6_nmea0183_match_epoch_publish(data);
+		return;
+	}
+
+	lx6_nmea0183_match_epoch_count(data, &data->epoch_stats.dropped);
+}
+
+static void lx6_nmea0183_match_epoch_timeout_handler(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct lx6_nmea0183_match_epoch *epoch =
+		CONTAINER_OF(dwork, struct lx6_nmea0183_match_epoch, timeout_work);
+	struct lx6_nmea0183_match_data *data =
+		CONTAINER_OF(epoch, struct lx6_nmea0183_match_data, epoch);
+
+	lx6_nmea0183_match_epoch_close(data);
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+/* Satellites used for fix are reported anew by the GSA messages of every epoch */
+static void lx6_nmea0183_match_used_svs_clear(struct lx6_nmea0183_match_data *data)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	memset(data->used_svs, 0, sizeof(data->used_svs));
+	k_spin_unlock(&data->lock, key);
+}
+#endif
+
+/*
+ * Find the epoch a sentence belongs to, closing the open epoch if the sentence
+ * starts a new one. Returns false if the sentence belongs to the last closed
+ * epoch, in which case it must not be committed.
+ */
+static bool lx6_nmea0183_match_epoch_begin(struct lx6_nmea0183_match_data *data,
+					   uint8_t sentence, uint32_t utc)
+{
+	struct lx6_nmea0183_match_epoch *epoch = &data->epoch;
+	uint8_t preceding = sentence;
+
+	/* Untimed sentences start a new epoch if the sentences they precede were received */
+	if (utc == LX6_NMEA0183_MATCH_UTC_NONE) {
+		preceding |= LX6_NMEA0183_MATCH_SENTENCES_AFTER_VTG;
+	}
+
+	if (epoch->open) {
+		if (((epoch->received & preceding) == 0) &&
+		    ((utc == LX6_NMEA0183_MATCH_UTC_NONE) ||
+		     (epoch->utc == LX6_NMEA0183_MATCH_UTC_NONE) || (utc == epoch->utc))) {
+			if (epoch->utc == LX6_NMEA0183_MATCH_UTC_NONE) {
+				epoch->utc = utc;
+			}
+
+			return true;
+		}
+
+		lx6_nmea0183_match_epoch_close(data);
+	}
+
+	/* Late sentence of an epoch which has already been closed */
+	if ((utc != LX6_NMEA0183_MATCH_UTC_NONE) && (utc == epoch->last_utc)) {
+		return false;
+	}
+
+#if CONFIG_GNSS_SATELLITES
+	/* Satellites of the previous epoch have all been received */
+	lx6_nmea0183_match_sky_flush(data);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+	lx6_nmea0183_match_used_svs_clear(data);
 #endif
 
-static void gnss_nmea0183_match_publish(struct gnss_nmea0183_match_data *data)
+	epoch->open = true;
+	epoch->utc = utc;
+	epoch->received = 0;
+	epoch->first_cycles = data->sentence_cycles;
+	(void)k_work_schedule_for_queue(data->workq, &epoch->timeout_work, data->epoch_timeout);
+	return true;
+}
+
+/* Mark sentence as received, publishing as soon as the last required sentence is received */
+static void lx6_nmea0183_match_epoch_commit(struct lx6_nmea0183_match_data *data, uint8_t sentence)
+{
+	struct lx6_nmea0183_match_epoch *epoch = &data->epoch;
+	uint8_t required = lx6_nmea0183_match_epoch_required(data);
+
+	epoch->received |= sentence;
+
+	if ((epoch->received & required) == required) {
+		lx6_nmea0183_match_epoch_close(data);
+	}
+}
+
+void lx6_nmea0183_match_gga_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
+{
+	struct lx6_nmea0183_match_data *data = user_data;
+	uint32_t utc;
+
+	if ((argc < 2) || (lx6_nmea0183_match_parse_utc(argv[1], &utc) < 0)) {
+		return;
+	}
+
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_GGA, utc)) {
+		return;
+	}
+
+	if (lx6_nmea0183_parse_gga((const char **)argv, argc, &data->data) < 0) {
+		return;
+	}
+
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_GGA);
+}
+
+void lx6_nmea0183_match_rmc_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
+{
+	struct lx6_nmea0183_match_data *data = user_data;
+	uint32_t utc;
+
+	if ((argc < 2) || (lx6_nmea0183_match_parse_utc(argv[1], &utc) < 0)) {
+		return;
+	}
+
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_RMC, utc)) {
+		return;
+	}
+
+	if (lx6_nmea0183_parse_rmc((const char **)argv, argc, &data->data) < 0) {
+		return;
+	}
+
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_RMC);
+}
+
+void lx6_nmea0183_match_vtg_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
+{
+	struct lx6_nmea0183_match_data *data = user_data;
+
+	/* VTG carries no time and is attributed to the open epoch */
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_VTG,
+					    LX6_NMEA0183_MATCH_UTC_NONE)) {
+		return;
+	}
+
+	if (lx6_nmea0183_parse_vtg((const char **)argv, argc, &data->data) < 0) {
+		return;
+	}
+
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_VTG);
+}
+
+void lx6_nmea0183_match_gll_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
 {
-	if ((data->gga_utc == 0) || (data->rmc_utc == 0)) {
+	struct lx6_nmea0183_match_data *data = user_data;
+	uint32_t utc;
+
+	if ((argc < 6) || (lx6_nmea0183_match_parse_utc(argv[5], &utc) < 0)) {
 		return;
 	}
 
-	if (data->gga_utc == data->rmc_utc) {
-		gnss_publish_data(data->gnss, &data->data);
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_GLL, utc)) {
+		return;
 	}
+
+	if (lx6_nmea0183_parse_gll((const char **)argv, argc, &data->data) < 0) {
+		return;
+	}
+
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_GLL);
 }
 
-void gnss_nmea0183_match_gga_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data)
+void lx6_nmea0183_match_zda_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
 {
-	struct gnss_nmea0183_match_data *data = user_data;
+	struct lx6_nmea0183_match_data *data = user_data;
+	uint32_t utc;
+
+	/* The date applies to the following epochs even if ZDA trails its own epoch */
+	if (lx6_nmea0183_parse_zda((const char **)argv, argc, &data->data.utc) < 0) {
+		return;
+	}
 
-	if (gnss_nmea0183_parse_gga((const char **)argv, argc, &data->data) < 0) {
+	if (lx6_nmea0183_match_parse_utc(argv[1], &utc) < 0) {
 		return;
 	}
 
-	if (gnss_nmea0183_match_parse_utc(argv, argc, &data->gga_utc) < 0) {
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_ZDA, utc)) {
 		return;
 	}
 
-	gnss_nmea0183_match_publish(data);
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_ZDA);
 }
 
-void gnss_nmea0183_match_rmc_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data)
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+void lx6_nmea0183_match_gst_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
 {
-	struct gnss_nmea0183_match_data *data = user_data;
+	struct lx6_nmea0183_match_data *data = user_data;
+	struct lx6_nmea0183_gst gst;
+	k_spinlock_key_t key;
+	uint32_t utc;
+	int ret;
 
-	if (gnss_nmea0183_parse_rmc((const char **)argv, argc, &data->data) < 0) {
+	/* Statistics are empty without fix, which still completes the epoch */
+	ret = lx6_nmea0183_parse_gst((const char **)argv, argc, &gst);
+	if ((ret < 0) && (ret != -ENODATA)) {
 		return;
 	}
 
-	if (gnss_nmea0183_match_parse_utc(argv, argc, &data->rmc_utc) < 0) {
+	if (lx6_nmea0183_match_parse_utc(argv[1], &utc) < 0) {
 		return;
 	}
 
-	gnss_nmea0183_match_publish(data);
+	if (!lx6_nmea0183_match_epoch_begin(data, LX6_NMEA0183_MATCH_SENTENCE_GST, utc)) {
+		return;
+	}
+
+	key = k_spin_lock(&data->lock);
+	data->gst_valid = (ret == 0);
+	if (data->gst_valid) {
+		data->gst = gst;
+	}
+	k_spin_unlock(&data->lock, key);
+
+	lx6_nmea0183_match_epoch_commit(data, LX6_NMEA0183_MATCH_SENTENCE_GST);
+}
+#endif
+
+int lx6_nmea0183_match_get_gst(struct lx6_nmea0183_match_data *data, struct lx6_nmea0183_gst *gst)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&data->lock);
+
+	if (!data->gst_valid) {
+		ret = -ENODATA;
+	} else {
+		*gst = data->gst;
+	}
+
+	k_spin_unlock(&data->lock, key);
+	return ret;
+#else
+	return -ENODATA;
+#endif
+}
+
+void lx6_nmea0183_match_set_accuracy_gate(struct lx6_nmea0183_match_data *data,
+					  uint32_t accuracy_gate)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	data->accuracy_gate = accuracy_gate;
+	k_spin_unlock(&data->lock, key);
+#endif
 }
 
 #if CONFIG_GNSS_SATELLITES
-void gnss_nmea0183_match_gsv_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data)
+void lx6_nmea0183_match_gsv_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
 {
-	struct gnss_nmea0183_match_data *data = user_data;
-	struct gnss_nmea0183_gsv_header header;
+	struct lx6_nmea0183_match_data *data = user_data;
+	struct lx6_nmea0183_match_sky *sky = &data->sky;
+	struct lx6_nmea0183_gsv_header header;
+	uint8_t index;
+	bool complete;
 	int ret;
 
-	if (gnss_nmea0183_parse_gsv_header((const char **)argv, argc, &header) < 0) {
+	if (lx6_nmea0183_parse_gsv_header((const char **)argv, argc, &header) < 0) {
 		return;
 	}
 
-	if (header.number_of_svs == 0) {
+	index = lx6_nmea0183_match_system_index(header.system);
+	if (index >= LX6_NMEA0183_MATCH_SYSTEMS) {
 		return;
 	}
 
-	if (header.message_number != data->gsv_message_number) {
-		gnss_nmea0183_match_reset_gsv(data);
+	if (header.message_number == 1) {
+		/* System already received within the sky view, which is thus over */
+		if (sky->started & BIT(index)) {
+			lx6_nmea0183_match_sky_flush(data);
+		}
+
+		sky->started |= BIT(index);
+		sky->message_number[index] = 1;
+		sky->first[index] = data->satellites_length;
+	}
+
+	/* Rest of a sequence which has already been discarded */
+	if (sky->message_number[index] == 0) {
 		return;
 	}
 
-	data->gsv_message_number++;
+	/* Sequences of other systems are kept if a message of this one is lost */
+	if (header.message_number != sky->message_number[index]) {
+		goto discard;
+	}
+
+	sky->message_number[index]++;
 
-	ret = gnss_nmea0183_parse_gsv_svs((const char **)argv, argc,
-					  &data->satellites[data->satellites_length],
-					  data->satellites_size - data->satellites_length);
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	ret = lx6_nmea0183_parse_gsv_svs((const char **)argv, argc, data->sat_chunk,
+					 ARRAY_SIZE(data->sat_chunk));
+#else
+	ret = lx6_nmea0183_parse_gsv_svs((const char **)argv, argc,
+					 &data->satellites[data->satellites_length],
+					 data->satellites_size - data->satellites_length);
+#endif
 	if (ret < 0) {
-		gnss_nmea0183_match_reset_gsv(data);
-		return;
+		goto discard;
 	}
 
 	data->satellites_length += (uint16_t)ret;
 
-	if (data->satellites_length == header.number_of_svs) {
-		gnss_publish_satellites(data->gnss, data->satellites, data->satellites_length);
-		gnss_nmea0183_match_reset_gsv(data);
+	if (header.message_number == header.number_of_messages) {
+		sky->message_number[index] = 0;
+		sky->completed |= BIT(index);
 	}
+
+	complete = (sky->expected != 0) && ((sky->completed & sky->expected) == sky->expected) &&
+		   lx6_nmea0183_match_sky_publishable(data);
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	if ((ret > 0) || complete) {
+		lx6_nmea0183_match_sky_stream(data, data->sat_chunk, (uint16_t)ret,
+					      complete ? LX6_NMEA0183_MATCH_SAT_STREAM_END : 0);
+	}
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	lx6_nmea0183_match_sat_report(data, data->sat_chunk, (uint16_t)ret);
+#endif
+#endif
+
+	if (complete) {
+		(void)k_work_cancel_delayable(&sky->timeout_work);
+		lx6_nmea0183_match_sky_publish(data);
+		return;
+	}
+
+	/* Otherwise flushed by the next epoch, which may only come after the receiver slept */
+	(void)k_work_reschedule_for_queue(data->workq, &sky->timeout_work, data->epoch_timeout);
+	return;
+
+discard:
+	sky->message_number[index] = 0;
+#if !CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	lx6_nmea0183_match_sky_discard(data, header.system, sky->first[index]);
+#endif
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+/* PRNs of a system span less than 64 values once aligned, modulo keeps them unique */
+static inline uint64_t lx6_nmea0183_match_prn_bit(uint16_t prn)
+{
+	return BIT64(prn & 63);
+}
+
+void lx6_nmea0183_match_gsa_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data)
+{
+	struct lx6_nmea0183_match_data *data = user_data;
+	struct lx6_nmea0183_gsa gsa;
+	k_spinlock_key_t key;
+	uint8_t index;
+
+	if (lx6_nmea0183_parse_gsa((const char **)argv, argc, &gsa) < 0) {
+		return;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	data->dop = gsa.dop;
+
+	for (uint8_t i = 0; i < gsa.svs_size; i++) {
+		index = lx6_nmea0183_match_system_index(gsa.svs[i].system);
+		if (index >= LX6_NMEA0183_MATCH_SYSTEMS) {
+			continue;
+		}
+
+		data->used_svs[index] |= lx6_nmea0183_match_prn_bit(gsa.svs[i].prn);
+	}
+
+	k_spin_unlock(&data->lock, key);
+}
+#endif
+
+int lx6_nmea0183_match_get_dop(struct lx6_nmea0183_match_data *data, struct lx6_nmea0183_dop *dop)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&data->lock);
+
+	if (data->dop.pdop == 0) {
+		ret = -ENODATA;
+	} else {
+		*dop = data->dop;
+	}
+
+	k_spin_unlock(&data->lock, key);
+	return ret;
+#else
+	return -ENODATA;
+#endif
 }
+
+bool lx6_nmea0183_match_is_used(struct lx6_nmea0183_match_data *data,
+				const struct gnss_satellite *satellite)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+	uint8_t index = lx6_nmea0183_match_system_index(satellite->system);
+	k_spinlock_key_t key;
+	bool used;
+
+	if (index >= LX6_NMEA0183_MATCH_SYSTEMS) {
+		return false;
+	}
+
+	key = k_spin_lock(&data->lock);
+	used = (data->used_svs[index] & lx6_nmea0183_match_prn_bit(satellite->prn)) != 0;
+	k_spin_unlock(&data->lock, key);
+	return used;
+#else
+	return false;
+#endif
+}
+
+static const struct lx6_nmea0183_match_handler
+	lx6_nmea0183_match_handlers[LX6_NMEA0183_MATCH_TABLE_SIZE] = {
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_GGA,
+					   lx6_nmea0183_match_gga_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_RMC
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_RMC,
+					   lx6_nmea0183_match_rmc_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GLL
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_GLL,
+					   lx6_nmea0183_match_gll_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_VTG
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_VTG,
+					   lx6_nmea0183_match_vtg_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_ZDA
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_ZDA,
+					   lx6_nmea0183_match_zda_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_GST,
+					   lx6_nmea0183_match_gst_callback),
 #endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSV
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_GSV,
+					   lx6_nmea0183_match_gsv_callback),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+		LX6_NMEA0183_MATCH_HANDLER(LX6_NMEA0183_MATCH_TYPE_GSA,
+					   lx6_nmea0183_match_gsa_callback),
+#endif
+};
 
-int gnss_nmea0183_match_init(struct gnss_nmea0183_match_data *data,
-			     const struct gnss_nmea0183_match_config *config)
+static inline uint32_t lx6_nmea0183_match_letter(char c)
+{
+	return ((c >= 'A') && (c <= 'Z')) ? (uint32_t)(c - '@') : 0;
+}
+
+uint32_t lx6_nmea0183_match_key(const char *message_id)
+{
+	uint32_t key = 0;
+	uint32_t letter;
+
+	__ASSERT(message_id != NULL, "message_id argument must be provided");
+
+	if (message_id[0] != '$') {
+		return 0;
+	}
+
+	/* Pack talker and sentence type, stopping at first char which is not a letter */
+	for (uint8_t i = 1; i < LX6_NMEA0183_MATCH_MESSAGE_ID_SIZE; i++) {
+		letter = lx6_nmea0183_match_letter(message_id[i]);
+		if (letter == 0) {
+			return 0;
+		}
+
+		key = (key << 5) | letter;
+	}
+
+	/* Modem chat matches keep the separator which ends the message id */
+	switch (message_id[LX6_NMEA0183_MATCH_MESSAGE_ID_SIZE]) {
+	case '\0':
+	case ',':
+		return key;
+	default:
+		return 0;
+	}
+}
+
+int lx6_nmea0183_match_get_epoch_stats(struct lx6_nmea0183_match_data *data,
+				       struct lx6_nmea0183_match_epoch_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	*stats = data->epoch_stats;
+	k_spin_unlock(&data->lock, key);
+	return 0;
+}
+
+void lx6_nmea0183_match_reset_epoch_stats(struct lx6_nmea0183_match_data *data)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+	memset(&data->epoch_stats, 0, sizeof(data->epoch_stats));
+	k_spin_unlock(&data->lock, key);
+}
+
+int lx6_nmea0183_match_set_epoch_required(struct lx6_nmea0183_match_data *data, uint8_t sentences)
+{
+	if ((sentences == 0) || ((sentences & ~LX6_NMEA0183_MATCH_SENTENCE_ALL) != 0)) {
+		return -EINVAL;
+	}
+
+	data->epoch_required = sentences;
+	return 0;
+}
+
+uint8_t lx6_nmea0183_match_get_epoch_required(const struct lx6_nmea0183_match_data *data)
+{
+	return data->epoch_required;
+}
+
+void lx6_nmea0183_match_set_epoch_decimated(struct lx6_nmea0183_match_data *data, uint8_t sentences)
+{
+	data->epoch_decimated = sentences & LX6_NMEA0183_MATCH_SENTENCE_ALL;
+}
+
+void lx6_nmea0183_match_dispatch_timestamped(struct lx6_nmea0183_match_data *data, char **argv,
+					     uint16_t argc, uint32_t cycles)
+{
+	const struct lx6_nmea0183_match_handler *handler;
+	uint32_t type;
+
+	if (argc < 1) {
+		return;
+	}
+
+	type = lx6_nmea0183_match_key(argv[0]) & LX6_NMEA0183_MATCH_TYPE_MASK;
+	handler = &lx6_nmea0183_match_handlers[LX6_NMEA0183_MATCH_SLOT(type)];
+
+	if ((handler->callback == NULL) || (handler->type != type)) {
+		return;
+	}
+
+	data->sentence_cycles = cycles;
+	handler->callback(NULL, argv, argc, data);
+}
+
+void lx6_nmea0183_match_dispatch(struct lx6_nmea0183_match_data *data, char **argv, uint16_t argc)
+{
+	lx6_nmea0183_match_dispatch_timestamped(data, argv, argc, k_cycle_get_32());
+}
+
+void lx6_nmea0183_match_dispatch_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+					  void *user_data)
+{
+	lx6_nmea0183_match_dispatch(user_data, argv, argc);
+}
+
+int lx6_nmea0183_match_init(struct lx6_nmea0183_match_data *data,
+			    const struct lx6_nmea0183_match_config *config)
 {
 	__ASSERT(data != NULL, "data argument must be provided");
 	__ASSERT(config != NULL, "config argument must be provided");
 
-	memset(data, 0, sizeof(struct gnss_nmea0183_match_data));
+	if ((config->epoch_required == 0) ||
+	    ((config->epoch_required & ~LX6_NMEA0183_MATCH_SENTENCE_ALL) != 0)) {
+		return -EINVAL;
+	}
+
+	memset(data, 0, sizeof(struct lx6_nmea0183_match_data));
+	data->epoch_required = config->epoch_required;
+	data->epoch_policy = config->epoch_policy;
+	data->epoch_timeout = config->epoch_timeout;
+	data->workq = (config->workq != NULL) ? config->workq : &k_sys_work_q;
+	data->epoch.last_utc = LX6_NMEA0183_MATCH_UTC_NONE;
+	k_work_init_delayable(&data->epoch.timeout_work, lx6_nmea0183_match_epoch_timeout_handler);
 	data->gnss = config->gnss;
 #if CONFIG_GNSS_SATELLITES
 	data->satellites = config->satellites;
 	data->satellites_size = config->satellites_size;
+	data->sky.published_utc = LX6_NMEA0183_MATCH_UTC_NONE;
+	k_work_init_delayable(&data->sky.timeout_work, lx6_nmea0183_match_sky_timeout_handler);
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	data->accuracy_gate = config->accuracy_gate;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	data->history = config->history;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	data->data_callback = config->data_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	data->fix_callback = config->fix_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	data->sat_stream_callback = config->sat_stream_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	data->sat_delta_callback = config->sat_delta_callback;
+	data->sat_snr_hysteresis = config->sat_snr_hysteresis;
+	data->sat_elevation_hysteresis = config->sat_elevation_hysteresis;
+	data->sat_max_age = config->sat_max_age;
 #endif
 	return 0;
 }
@@ -9,61 +9,344 @@
  * passed to said handlers, to parse the NMEA0183 messages received from a NMEA0183
  * based GNSS device.
  *
- * The context struct gnss_nmea0183_match_data *data is placed as the first member
+ * The context struct lx6_nmea0183_match_data *data is placed as the first member
  * of the data structure which is passed to the modem_chat instance through the
  * user_data member.
  *
  *   struct my_gnss_nmea0183_driver {
- *           gnss_nmea0183_match_data match_data;
+ *           lx6_nmea0183_match_data match_data;
  *           ...
  *   };
  *
- * The struct gnss_nmea0183_match_data context must be initialized using
- * gnss_nmea0183_match_init().
+ * The struct lx6_nmea0183_match_data context must be initialized using
+ * lx6_nmea0183_match_init().
  *
- * When initializing the modem_chat instance, the three match callbacks must be added
- * as part of the unsolicited matches.
+ * When initializing the modem_chat instance, the dispatch callback must be added
+ * as part of the unsolicited matches, matching the whole message id so that it is
+ * passed as the first argument.
  *
  *   MODEM_CHAT_MATCHES_DEFINE(unsol_matches,
- *           MODEM_CHAT_MATCH_WILDCARD("$??GGA,", ",*", gnss_nmea0183_match_gga_callback),
- *           MODEM_CHAT_MATCH_WILDCARD("$??RMC,", ",*", gnss_nmea0183_match_rmc_callback),
+ *           MODEM_CHAT_MATCH_WILDCARD("$?????,", ",*", lx6_nmea0183_match_dispatch_callback),
+ *
+ * The dispatch callback packs the talker and sentence type into an integer key
+ * and looks up the handler of the sentence type in a constant-time table. The
+ * handlers compiled into the table are selected through Kconfig. Alternatively,
+ * the per sentence match callbacks can be added as individual wildcard matches.
+ *
+ *   MODEM_CHAT_MATCHES_DEFINE(unsol_matches,
+ *           MODEM_CHAT_MATCH_WILDCARD("$??GGA,", ",*", lx6_nmea0183_match_gga_callback),
+ *           MODEM_CHAT_MATCH_WILDCARD("$??RMC,", ",*", lx6_nmea0183_match_rmc_callback),
  *   #if CONFIG_GNSS_SATELLITES
- *           MODEM_CHAT_MATCH_WILDCARD("$??GSV,", ",*", gnss_nmea0183_match_gsv_callback),
+ *           MODEM_CHAT_MATCH_WILDCARD("$??GSV,", ",*", lx6_nmea0183_match_gsv_callback),
  *   #endif
  *
+ * Navigation sentences are grouped into epochs by their UTC time. An epoch is
+ * published as soon as all of its required sentences have been received. An
+ * epoch missing some of them is either dropped or published partially, once a
+ * sentence of the next epoch is received or the epoch timeout expires. Sentences
+ * decimated by the receiver, output every n epochs only, are not awaited and
+ * their latest values are kept in between. The epoch timeout work is submitted
+ * to the configured work queue, or to the system work queue if none, which must
+ * be the one running the match callbacks.
+ *
+ * The GSV sequences of all systems within a cycle are gathered into a single
+ * sky view, which is published once per epoch. Epochs without GSV sentences,
+ * when decimated, publish no sky view. Alternatively, the satellites of
+ * every GSV sentence may be streamed as they are parsed, with constant RAM usage.
  */
 
-#ifndef ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_MATCH_H_
-#define ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_MATCH_H_
+#ifndef ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_MATCH_H_
+#define ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_MATCH_H_
 
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/gnss.h>
+#include <zephyr/kernel.h>
 #include <zephyr/modem/chat.h>
+#include <zephyr/sys/atomic.h>
+
+#include "gnss_nmea0183.h"
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+#include "gnss_history.h"
+#endif
+
+/** Number of GNSS systems, one per bit of enum gnss_system */
+#define LX6_NMEA0183_MATCH_SYSTEMS (8)
+
+/** Sentences which make up an epoch */
+#define LX6_NMEA0183_MATCH_SENTENCE_GGA BIT(0)
+#define LX6_NMEA0183_MATCH_SENTENCE_RMC BIT(1)
+#define LX6_NMEA0183_MATCH_SENTENCE_GLL BIT(2)
+#define LX6_NMEA0183_MATCH_SENTENCE_VTG BIT(3)
+#define LX6_NMEA0183_MATCH_SENTENCE_ZDA BIT(4)
+#define LX6_NMEA0183_MATCH_SENTENCE_GST BIT(5)
+#define LX6_NMEA0183_MATCH_SENTENCE_ALL (BIT(6) - 1)
+
+/** UTC of an epoch which has not been timed yet */
+#define LX6_NMEA0183_MATCH_UTC_NONE (UINT32_MAX)
+
+/** Number of buckets of latency histograms */
+#define LX6_NMEA0183_MATCH_LATENCY_BUCKETS (24)
+
+/** Handling of epochs missing required sentences */
+enum lx6_nmea0183_match_epoch_policy {
+	/** Drop incomplete epochs */
+	LX6_NMEA0183_MATCH_EPOCH_DROP = 0,
+	/** Publish incomplete epochs which contain at least one required sentence */
+	LX6_NMEA0183_MATCH_EPOCH_PUBLISH_PARTIAL,
+};
+
+/** Latency distribution */
+struct lx6_nmea0183_match_latency {
+	/** Number of samples */
+	uint32_t count;
+	/** Minimum latency in microseconds */
+	uint32_t min_us;
+	/** Maximum latency in microseconds */
+	uint32_t max_us;
+	/** Sum of latencies in microseconds */
+	uint64_t total_us;
+	/** Bucket n counts latencies within [2^n, 2^(n+1)) microseconds */
+	uint32_t histogram[LX6_NMEA0183_MATCH_LATENCY_BUCKETS];
+};
+
+/** Epoch assembler statistics */
+struct lx6_nmea0183_match_epoch_stats {
+	/** Number of epochs containing all required sentences */
+	uint32_t complete;
+	/** Number of incomplete epochs which have been published */
+	uint32_t partial;
+	/** Number of incomplete epochs which have been dropped */
+	uint32_t dropped;
+	/** Number of epochs dropped by the accuracy gate */
+	uint32_t gated;
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+	/** Latency from first byte of epoch to reception of its last sentence */
+	struct lx6_nmea0183_match_latency assembly;
+	/** Latency from first byte of epoch to publication */
+	struct lx6_nmea0183_match_latency publish;
+#endif
+};
+
+struct lx6_nmea0183_match_epoch {
+	struct k_work_delayable timeout_work;
+	uint32_t utc;
+	uint32_t last_utc;
+	uint32_t first_cycles;
+	uint32_t complete_cycles;
+	uint8_t received;
+	bool open;
+};
+
+#if CONFIG_GNSS_SATELLITES
+/*
+ * GSV sequences of every system received within a cycle, published at once. A
+ * sky view is published as soon as all the systems of the previous one have been
+ * received, or otherwise at the next epoch or once a system restarts its sequence,
+ * at most once per epoch.
+ */
+struct lx6_nmea0183_match_sky {
+	/* Flushes a pending sky view once GSV sentences stop, like when the receiver sleeps */
+	struct k_work_delayable timeout_work;
+	/* Next message number of the sequence of each system, 0 if not in progress */
+	uint8_t message_number[LX6_NMEA0183_MATCH_SYSTEMS];
+	/* Bits of systems whose sequence started within the sky view */
+	uint8_t started;
+	/* Bits of systems whose sequence completed within the sky view */
+	uint8_t completed;
+	/* Bits of systems completed within the previous sky view */
+	uint8_t expected;
+	/* Index of the first satellite of the sequence of each system */
+	uint16_t first[LX6_NMEA0183_MATCH_SYSTEMS];
+	/* UTC of the epoch a sky view was last published for */
+	uint32_t published_utc;
+	bool published;
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	/* Start of the sky view has been streamed, but not its end */
+	bool streaming;
+#endif
+};
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+/** Maximum number of satellites in a GSV sentence, thus in a streamed chunk */
+#define LX6_NMEA0183_MATCH_SAT_CHUNK_SIZE (4)
+
+/** First chunk of a sky view */
+#define LX6_NMEA0183_MATCH_SAT_STREAM_START BIT(0)
+/** Last chunk of a sky view */
+#define LX6_NMEA0183_MATCH_SAT_STREAM_END   BIT(1)
+
+/**
+ * @brief Callback invoked with every chunk of streamed satellites
+ *
+ * @param gnss The GNSS device from which the satellites are streamed
+ * @param satellites Satellites of chunk, only valid for the duration of the callback
+ * @param size Number of satellites in chunk, may be 0 for the last chunk
+ * @param flags LX6_NMEA0183_MATCH_SAT_STREAM_* markers, 0 for a chunk in between
+ */
+typedef void (*lx6_nmea0183_match_sat_stream_callback)(const struct device *gnss,
+							 const struct gnss_satellite *satellites,
+							 uint16_t size, uint8_t flags);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY || CONFIG_GNSS_QUECTEL_LX6_TTFF
+/**
+ * @brief Callback invoked once per published epoch
+ *
+ * @param gnss The GNSS device from which the data is published
+ * @param data Published data
+ */
+typedef void (*lx6_nmea0183_match_data_callback)(const struct device *gnss,
+						   const struct gnss_data *data);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+/** Change of a satellite since it was last notified */
+enum lx6_nmea0183_match_sat_change {
+	/** Satellite has been reported for the first time */
+	LX6_NMEA0183_MATCH_SAT_ADDED = 0,
+	/** Tracking state, SNR or elevation of satellite changed beyond hysteresis */
+	LX6_NMEA0183_MATCH_SAT_CHANGED,
+	/** Satellite has not been reported for too long */
+	LX6_NMEA0183_MATCH_SAT_REMOVED,
+};
+
+/** Satellite notified to the delta callback */
+struct lx6_nmea0183_match_sat_delta {
+	/** Satellite as reported, or as last notified if removed */
+	struct gnss_satellite satellite;
+	/** Change of satellite */
+	enum lx6_nmea0183_match_sat_change change;
+};
+
+/**
+ * @brief Callback invoked with the satellites which changed within a sky view
+ *
+ * @param gnss The GNSS device from which the satellites are published
+ * @param deltas Changed satellites
+ * @param size Number of changed satellites
+ */
+typedef void (*lx6_nmea0183_match_sat_delta_callback)(
+	const struct device *gnss, const struct lx6_nmea0183_match_sat_delta *deltas,
+	uint16_t size);
+
+/* Entry of the satellite table, keyed by system and PRN */
+struct lx6_nmea0183_match_sat_entry {
+	/* Satellite as last notified */
+	struct gnss_satellite satellite;
+	/* Number of sky views since satellite was last reported */
+	uint8_t age;
+	/* LX6_NMEA0183_MATCH_SAT_FLAG_* */
+	uint8_t flags;
+};
+#endif
 
-struct gnss_nmea0183_match_data {
+struct lx6_nmea0183_match_data {
 	const struct device *gnss;
 	struct gnss_data data;
 #if CONFIG_GNSS_SATELLITES
 	struct gnss_satellite *satellites;
 	uint16_t satellites_size;
 	uint16_t satellites_length;
+	struct lx6_nmea0183_match_sky sky;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	struct gnss_satellite sat_chunk[LX6_NMEA0183_MATCH_SAT_CHUNK_SIZE];
+	lx6_nmea0183_match_sat_stream_callback sat_stream_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	/* Open addressed with linear probing, sized to a power of two */
+	struct lx6_nmea0183_match_sat_entry sat_table[CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE_SIZE];
+	struct lx6_nmea0183_match_sat_delta sat_deltas[CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE_SIZE];
+	lx6_nmea0183_match_sat_delta_callback sat_delta_callback;
+	uint8_t sat_snr_hysteresis;
+	uint8_t sat_elevation_hysteresis;
+	uint8_t sat_max_age;
+#endif
+	struct lx6_nmea0183_match_epoch epoch;
+	uint8_t epoch_required;
+	uint8_t epoch_decimated;
+	enum lx6_nmea0183_match_epoch_policy epoch_policy;
+	k_timeout_t epoch_timeout;
+	struct k_work_q *workq;
+	uint32_t sentence_cycles;
+	/* Protects data which is accessed from other threads */
+	struct k_spinlock lock;
+	struct lx6_nmea0183_match_epoch_stats epoch_stats;
+#if CONFIG_GNSS_QUECTEL_LX6_LATEST_FIX
+	/* Double buffered snapshot of the latest published data, guarded by a sequence */
+	atomic_t latest_seq;
+	struct gnss_data latest[2];
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	struct gnss_history *history;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	lx6_nmea0183_match_data_callback data_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	lx6_nmea0183_match_data_callback fix_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+	struct lx6_nmea0183_dop dop;
+	uint64_t used_svs[LX6_NMEA0183_MATCH_SYSTEMS];
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	struct lx6_nmea0183_gst gst;
+	bool gst_valid;
+	uint32_t accuracy_gate;
 #endif
-	uint32_t gga_utc;
-	uint32_t rmc_utc;
-	uint8_t gsv_message_number;
 };
 
 /** GNSS NMEA0183 match configuration structure */
-struct gnss_nmea0183_match_config {
+struct lx6_nmea0183_match_config {
 	/** The GNSS device from which the data is published */
 	const struct device *gnss;
 #if CONFIG_GNSS_SATELLITES
-	/** Buffer for parsed satellites */
+	/** Buffer for parsed satellites, unused if satellites are streamed */
 	struct gnss_satellite *satellites;
 	/** Number of elements in buffer for parsed satellites */
 	uint16_t satellites_size;
 #endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	/** Callback invoked with streamed satellites instead of publishing sky views */
+	lx6_nmea0183_match_sat_stream_callback sat_stream_callback;
+#endif
+	/** Sentences which must be received for an epoch to be complete */
+	uint8_t epoch_required;
+	/** Handling of epochs missing required sentences */
+	enum lx6_nmea0183_match_epoch_policy epoch_policy;
+	/** Time after the first sentence of an epoch after which it is closed */
+	k_timeout_t epoch_timeout;
+	/** Work queue running the match callbacks, NULL for the system work queue */
+	struct k_work_q *workq;
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	/** Horizontal standard deviation gate in millimeters, 0 to disable */
+	uint32_t accuracy_gate;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	/** History in which published fixes are stored, NULL to disable */
+	struct gnss_history *history;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	/** Callback invoked with every published epoch, NULL to disable */
+	lx6_nmea0183_match_data_callback data_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	/** Callback invoked with every epoch about to be published, before the accuracy gate */
+	lx6_nmea0183_match_data_callback fix_callback;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	/** Callback invoked with changed satellites, NULL to disable */
+	lx6_nmea0183_match_sat_delta_callback sat_delta_callback;
+	/** Minimum SNR change in dB for a satellite to be notified as changed */
+	uint8_t sat_snr_hysteresis;
+	/** Minimum elevation change in degrees for a satellite to be notified as changed */
+	uint8_t sat_elevation_hysteresis;
+	/** Number of sky views a satellite may be missing from before being removed */
+	uint8_t sat_max_age;
+#endif
 };
 
 /**
@@ -71,24 +354,233 @@ struct gnss_nmea0183_match_config {
  *
  * @details Should be used as the callback of a modem_chat match which matches "$??GGA,"
  */
-void gnss_nmea0183_match_gga_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data);
+void lx6_nmea0183_match_gga_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
 
 /**
  * @brief Match callback for the NMEA RMC NMEA0183 message
  *
  * @details Should be used as the callback of a modem_chat match which matches "$??RMC,"
  */
-void gnss_nmea0183_match_rmc_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data);
+void lx6_nmea0183_match_rmc_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Match callback for the NMEA GLL NMEA0183 message
+ *
+ * @details Should be used as the callback of a modem_chat match which matches "$??GLL,"
+ */
+void lx6_nmea0183_match_gll_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Match callback for the NMEA VTG NMEA0183 message
+ *
+ * @details Should be used as the callback of a modem_chat match which matches "$??VTG,"
+ */
+void lx6_nmea0183_match_vtg_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Match callback for the NMEA ZDA NMEA0183 message
+ *
+ * @details Should be used as the callback of a modem_chat match which matches "$??ZDA,"
+ */
+void lx6_nmea0183_match_zda_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
 
 /**
  * @brief Match callback for the NMEA GSV NMEA0183 message
  *
  * @details Should be used as the callback of a modem_chat match which matches "$??GSV,"
+ * for every talker. Satellites of all talkers are published together.
+ */
+void lx6_nmea0183_match_gsv_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Match callback for the NMEA GSA NMEA0183 message
+ *
+ * @details Should be used as the callback of a modem_chat match which matches "$??GSA,"
+ */
+void lx6_nmea0183_match_gsa_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Get dilution of precision of the last parsed GSA message
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param dop Destination for dilution of precision
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no GSA message has been parsed yet
+ */
+int lx6_nmea0183_match_get_dop(struct lx6_nmea0183_match_data *data, struct lx6_nmea0183_dop *dop);
+
+/**
+ * @brief Check if a satellite is used for fix
+ *
+ * @details The satellites used for fix are those of the GSA messages of the
+ * current epoch, which precede the GSV messages. The lookup is O(1).
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param satellite Satellite, as published by GSV messages
+ *
+ * @retval true if satellite is used for fix
+ * @retval false otherwise
+ */
+bool lx6_nmea0183_match_is_used(struct lx6_nmea0183_match_data *data,
+				const struct gnss_satellite *satellite);
+
+/**
+ * @brief Match callback for the NMEA GST NMEA0183 message
+ *
+ * @details Should be used as the callback of a modem_chat match which matches "$??GST,".
+ * Navigation data of an epoch is only published if it passes the accuracy gate.
+ */
+void lx6_nmea0183_match_gst_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				     void *user_data);
+
+/**
+ * @brief Get error statistics of the last parsed GST message
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param gst Destination for error statistics
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no GST message has been parsed yet
+ */
+int lx6_nmea0183_match_get_gst(struct lx6_nmea0183_match_data *data, struct lx6_nmea0183_gst *gst);
+
+/**
+ * @brief Set accuracy gate
+ *
+ * @details Epochs with a fix whose horizontal standard deviation, computed from
+ * the GST latitude and longitude standard deviations, exceeds the gate are not
+ * published. Loss of fix is always published.
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param accuracy_gate Horizontal standard deviation in millimeters, 0 to disable
+ */
+void lx6_nmea0183_match_set_accuracy_gate(struct lx6_nmea0183_match_data *data,
+					  uint32_t accuracy_gate);
+
+/**
+ * @brief Get epoch assembler statistics
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param stats Destination for statistics
+ *
+ * @retval 0 if successful
+ */
+int lx6_nmea0183_match_get_epoch_stats(struct lx6_nmea0183_match_data *data,
+				       struct lx6_nmea0183_match_epoch_stats *stats);
+
+/**
+ * @brief Reset epoch assembler statistics
+ *
+ * @param data GNSS NMEA0183 match instance
+ */
+void lx6_nmea0183_match_reset_epoch_stats(struct lx6_nmea0183_match_data *data);
+
+/**
+ * @brief Set sentences which must be received for an epoch to be complete
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param sentences Mask of LX6_NMEA0183_MATCH_SENTENCE_* bits
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if mask is empty or contains unknown sentences
+ */
+int lx6_nmea0183_match_set_epoch_required(struct lx6_nmea0183_match_data *data, uint8_t sentences);
+
+/**
+ * @brief Get sentences which must be received for an epoch to be complete
+ *
+ * @param data GNSS NMEA0183 match instance
+ *
+ * @returns Mask of LX6_NMEA0183_MATCH_SENTENCE_* bits
+ */
+uint8_t lx6_nmea0183_match_get_epoch_required(const struct lx6_nmea0183_match_data *data);
+
+/**
+ * @brief Set sentences which are not output every epoch
+ *
+ * @details Decimated sentences are not awaited to complete epochs, even if
+ * required, unless all required sentences are decimated. They are still parsed
+ * into the epochs they are received in.
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param sentences Mask of LX6_NMEA0183_MATCH_SENTENCE_* bits
+ */
+void lx6_nmea0183_match_set_epoch_decimated(struct lx6_nmea0183_match_data *data,
+					    uint8_t sentences);
+
+/**
+ * @brief Get a snapshot of the latest published navigation data
+ *
+ * @details Lock-free, may be called from any thread. The parser is never
+ * blocked, a reader retries if the snapshot was overwritten while copied.
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param latest Destination for navigation data
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no navigation data has been published yet
+ * @retval -ENOTSUP if snapshots are disabled
+ */
+int lx6_nmea0183_match_get_latest(struct lx6_nmea0183_match_data *data, struct gnss_data *latest);
+
+/**
+ * @brief Pack the talker and sentence type of a NMEA0183 message id into a key
+ *
+ * @details Each of the 5 letters is packed in 5 bits, the sentence type in the
+ * lower 15 bits and the talker in the upper 10 bits.
+ *
+ * @example "$GPGGA" -> key of talker "GP" and sentence type "GGA"
+ * @example "$GPGGA," -> same key, as matched by modem chat
+ *
+ * @param message_id Message id including the leading '$', optionally followed by ','
+ *
+ * @retval 0 if message id is not a talker followed by a sentence type
+ * @retval key otherwise
+ */
+uint32_t lx6_nmea0183_match_key(const char *message_id);
+
+/**
+ * @brief Dispatch a NMEA0183 message to the handler of its sentence type
+ *
+ * @details Messages of unknown or disabled sentence types are ignored in
+ * constant time.
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ */
+void lx6_nmea0183_match_dispatch(struct lx6_nmea0183_match_data *data, char **argv, uint16_t argc);
+
+/**
+ * @brief Dispatch a NMEA0183 message with the time at which it started being received
+ *
+ * @details Same as lx6_nmea0183_match_dispatch(), the timestamp is used as the
+ * start of the epoch if the message is the first of its epoch.
+ *
+ * @param data GNSS NMEA0183 match instance
+ * @param argv Array of arguments split by ',' including message id and checksum
+ * @param argc Number of arguments in argv
+ * @param cycles Cycle count at which the first byte of the message was received
+ */
+void lx6_nmea0183_match_dispatch_timestamped(struct lx6_nmea0183_match_data *data, char **argv,
+					     uint16_t argc, uint32_t cycles);
+
+/**
+ * @brief Match callback dispatching all NMEA0183 messages
+ *
+ * @details Should be used as the callback of a modem_chat wildcard match of the
+ * whole message id, like "$?????,"
  */
-void gnss_nmea0183_match_gsv_callback(struct modem_chat *chat, char **argv, uint16_t argc,
-				      void *user_data);
+void lx6_nmea0183_match_dispatch_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+					  void *user_data);
 
 /**
  * @brief Initialize a GNSS NMEA0183 match instance
@@ -96,7 +588,7 @@ void gnss_nmea0183_match_gsv_callback(struct modem_chat *chat, char **argv, uint
  * @param data GNSS NMEA0183 match instance to initialize
  * @param config Configuration to apply to GNSS NMEA0183 match instance
  */
-int gnss_nmea0183_match_init(struct gnss_nmea0183_match_data *data,
-			     const struct gnss_nmea0183_match_config *config);
+int lx6_nmea0183_match_init(struct lx6_nmea0183_match_data *data,
+			    const struct lx6_nmea0183_match_config *config);
 
-#endif /* ZEPHYR_DRIVERS_GNSS_GNSS_NMEA0183_MATCH_H_ */
+#endif /* ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_NMEA0183_MATCH_H_ */
@@ -8,141 +8,285 @@
 
 #include <string.h>
 #include <errno.h>
-#include <stdlib.h>
 
 #include "gnss_parse.h"
 
-#define GNSS_PARSE_NANO_KNOTS_IN_MMS (1943840LL)
-#define GNSS_PARSE_NANO              (1000000000LL)
-#define GNSS_PARSE_MICRO             (1000000LL)
-#define GNSS_PARSE_MILLI             (1000LL)
+#define LX6_PARSE_NANO_KNOTS_IN_MMS (1943840LL)
+#define LX6_PARSE_NANO_DIGITS       (9)
+#define LX6_PARSE_MICRO_DIGITS      (6)
+#define LX6_PARSE_MILLI_DIGITS      (3)
+#define LX6_PARSE_SCALED_MAX        ((uint64_t)(INT64_MAX / 10))
+#define LX6_PARSE_FIXED_DIGITS_MAX  (9)
 
-int gnss_parse_dec_to_nano(const char *str, int64_t *nano)
+static inline bool lx6_parse_is_digit(char c)
 {
-	int64_t sum = 0;
-	int8_t decimal = -1;
-	int8_t pos = 0;
-	int8_t start = 0;
-	int64_t increment;
-
-	__ASSERT(str != NULL, "str argument must be provided");
-	__ASSERT(nano != NULL, "nano argument must be provided");
+	return (c >= '0') && (c <= '9');
+}
 
-	/* Find decimal */
-	while (str[pos] != '\0') {
-		/* Verify if char is decimal */
-		if (str[pos] == '.') {
-			decimal = pos;
-			break;
-		}
+/*
+ * Parse a signed decimal string to a fixed-point integer holding frac_digits
+ * decimals, in a single forward pass. Decimals beyond frac_digits are validated
+ * but truncated, which is equivalent to scaling to nano parts and dividing.
+ */
+static int lx6_parse_dec_to_scaled(const char *str, uint8_t frac_digits, int64_t *value)
+{
+	uint64_t sum = 0;
+	uint8_t decimals = 0;
+	uint8_t digit;
+	bool negative = false;
+	bool decimal = false;
 
-		/* Advance position */
-		pos++;
+	/* Skip sign if it exists */
+	if (*str == '-') {
+		negative = true;
+		str++;
 	}
 
-	/* Determine starting position based on decimal location */
-	pos = decimal < 0 ? pos - 1 : decimal - 1;
-
-	/* Skip sign if it exists */
-	start = str[0] == '-' ? 1 : 0;
+	while (*str != '\0') {
+		/* Switch to decimal part on first decimal point */
+		if ((*str == '.') && !decimal) {
+			decimal = true;
+			str++;
+			continue;
+		}
 
-	/* Add whole value to sum */
-	increment = GNSS_PARSE_NANO;
-	while (start <= pos) {
 		/* Verify char is decimal */
-		if (str[pos] < '0' || str[pos] > '9') {
+		if (!lx6_parse_is_digit(*str)) {
 			return -EINVAL;
 		}
 
-		/* Add value to sum */
-		sum += (str[pos] - '0') * increment;
-
-		/* Update increment */
-		increment *= 10;
+		/* Skip decimals which are beyond requested resolution */
+		if (decimal && (decimals == frac_digits)) {
+			str++;
+			continue;
+		}
 
-		/* Degrement position */
-		pos--;
-	}
+		digit = *str - '0';
+		if (sum > (((uint64_t)INT64_MAX - digit) / 10)) {
+			return -EINVAL;
+		}
 
-	/* Check if decimal was found */
-	if (decimal < 0) {
-		/* Set sign of sum */
-		sum = start == 1 ? -sum : sum;
+		/* Add value to sum */
+		sum = (sum * 10) + digit;
+		decimals += decimal ? 1 : 0;
 
-		*nano = sum;
-		return 0;
+		/* Advance position */
+		str++;
 	}
 
-	/* Convert decimal part to nano fractions and add it to sum */
-	pos = decimal + 1;
-	increment = GNSS_PARSE_NANO / 10LL;
-	while (str[pos] != '\0') {
-		/* Verify char is decimal */
-		if (str[pos] < '0' || str[pos] > '9') {
+	/* Scale sum up to requested resolution */
+	while (decimals < frac_digits) {
+		if (sum > LX6_PARSE_SCALED_MAX) {
 			return -EINVAL;
 		}
 
-		/* Add value to micro_degrees */
-		sum += (str[pos] - '0') * increment;
-
-		/* Update unit */
-		increment /= 10;
-
-		/* Increment position */
-		pos++;
+		sum *= 10;
+		decimals++;
 	}
 
 	/* Set sign of sum */
-	sum = start == 1 ? -sum : sum;
-
-	*nano = sum;
+	*value = negative ? -((int64_t)sum) : (int64_t)sum;
 	return 0;
 }
 
-int gnss_parse_dec_to_micro(const char *str, uint64_t *micro)
+int lx6_parse_dec_to_nano(const char *str, int64_t *nano)
+{
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(nano != NULL, "nano argument must be provided");
+
+	return lx6_parse_dec_to_scaled(str, LX6_PARSE_NANO_DIGITS, nano);
+}
+
+int lx6_parse_dec_to_micro(const char *str, uint64_t *micro)
 {
+	int64_t i64;
 	int ret;
 
 	__ASSERT(str != NULL, "str argument must be provided");
 	__ASSERT(micro != NULL, "micro argument must be provided");
 
-	ret = gnss_parse_dec_to_nano(str, micro);
+	ret = lx6_parse_dec_to_scaled(str, LX6_PARSE_MICRO_DIGITS, &i64);
 	if (ret < 0) {
 		return ret;
 	}
 
-	*micro = (*micro) / GNSS_PARSE_MILLI;
+	*micro = (uint64_t)i64;
 	return 0;
 }
 
-int gnss_parse_dec_to_milli(const char *str, int64_t *milli)
+int lx6_parse_dec_to_milli(const char *str, int64_t *milli)
 {
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(milli != NULL, "milli argument must be provided");
+
+	return lx6_parse_dec_to_scaled(str, LX6_PARSE_MILLI_DIGITS, milli);
+}
+
+int lx6_parse_fixed_digits(const char *str, uint8_t width, uint32_t *value)
+{
+	uint32_t sum = 0;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(value != NULL, "value argument must be provided");
+	__ASSERT(width <= LX6_PARSE_FIXED_DIGITS_MAX, "width exceeds uint32_t range");
+
+	for (uint8_t i = 0; i < width; i++) {
+		/* Verify char is decimal, this also rejects a premature end of string */
+		if (!lx6_parse_is_digit(str[i])) {
+			return -EINVAL;
+		}
+
+		sum = (sum * 10) + (str[i] - '0');
+	}
+
+	*value = sum;
+	return 0;
+}
+
+/*
+ * Parse an unsigned integer string of base up to 16, bounding the value while
+ * parsing so it can never overflow. Empty strings are rejected.
+ */
+static int lx6_parse_uint_bounded(const char *str, uint8_t base, uint32_t max, uint32_t *value)
+{
+	const uint32_t limit = max / base;
+	uint32_t sum = 0;
+	uint8_t digit;
+
+	/* Reject empty string */
+	if (*str == '\0') {
+		return -EINVAL;
+	}
+
+	while (*str != '\0') {
+		/* Convert char to digit, invalid chars are mapped beyond any base */
+		if (lx6_parse_is_digit(*str)) {
+			digit = *str - '0';
+		} else if ((*str >= 'A') && (*str <= 'F')) {
+			digit = *str - 'A' + 10;
+		} else if ((*str >= 'a') && (*str <= 'f')) {
+			digit = *str - 'a' + 10;
+		} else {
+			digit = UINT8_MAX;
+		}
+
+		/* Verify digit is valid in base and sum stays within bound */
+		if ((digit >= base) || (sum > limit)) {
+			return -EINVAL;
+		}
+
+		sum = (sum * base) + digit;
+		if (sum > max) {
+			return -EINVAL;
+		}
+
+		/* Advance position */
+		str++;
+	}
+
+	*value = sum;
+	return 0;
+}
+
+static int lx6_parse_int_bounded(const char *str, uint8_t base, int32_t min, int32_t max,
+				 int32_t *value)
+{
+	uint32_t magnitude;
 	int ret;
 
+	if (*str == '-') {
+		/* Negative values are bounded by min */
+		if (min >= 0) {
+			return -EINVAL;
+		}
+
+		ret = lx6_parse_uint_bounded(&str[1], base, 0U - (uint32_t)min, &magnitude);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*value = (int32_t)(0U - magnitude);
+	} else {
+		/* Positive values are bounded by max */
+		if (max < 0) {
+			return -EINVAL;
+		}
+
+		ret = lx6_parse_uint_bounded(str, base, (uint32_t)max, &magnitude);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*value = (int32_t)magnitude;
+	}
+
+	return (*value < min) || (*value > max) ? -EINVAL : 0;
+}
+
+int lx6_parse_dec_to_u8(const char *str, uint8_t min, uint8_t max, uint8_t *value)
+{
+	uint32_t u32;
+
 	__ASSERT(str != NULL, "str argument must be provided");
-	__ASSERT(milli != NULL, "milli argument must be provided");
+	__ASSERT(value != NULL, "value argument must be provided");
 
-	ret = gnss_parse_dec_to_nano(str, milli);
-	if (ret < 0) {
-		return ret;
+	if ((lx6_parse_uint_bounded(str, 10, max, &u32) < 0) || (u32 < min)) {
+		return -EINVAL;
 	}
 
-	(*milli) = (*milli) / GNSS_PARSE_MICRO;
+	*value = (uint8_t)u32;
 	return 0;
 }
 
-int gnss_parse_atoi(const char *str, uint8_t base, int32_t *integer)
+int lx6_parse_dec_to_u16(const char *str, uint16_t min, uint16_t max, uint16_t *value)
 {
-	char *end;
+	uint32_t u32;
 
 	__ASSERT(str != NULL, "str argument must be provided");
-	__ASSERT(integer != NULL, "integer argument must be provided");
+	__ASSERT(value != NULL, "value argument must be provided");
+
+	if ((lx6_parse_uint_bounded(str, 10, max, &u32) < 0) || (u32 < min)) {
+		return -EINVAL;
+	}
+
+	*value = (uint16_t)u32;
+	return 0;
+}
+
+int lx6_parse_dec_to_i32(const char *str, int32_t min, int32_t max, int32_t *value)
+{
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(value != NULL, "value argument must be provided");
 
-	*integer = (int32_t)strtol(str, &end, (int)base);
+	return lx6_parse_int_bounded(str, 10, min, max, value);
+}
+
+int lx6_parse_hex_to_u8(const char *str, uint8_t min, uint8_t max, uint8_t *value)
+{
+	uint32_t u32;
 
-	if ('\0' != (*end)) {
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(value != NULL, "value argument must be provided");
+
+	if ((lx6_parse_uint_bounded(str, 16, max, &u32) < 0) || (u32 < min)) {
 		return -EINVAL;
 	}
 
+	*value = (uint8_t)u32;
 	return 0;
 }
+
+int lx6_parse_atoi(const char *str, uint8_t base, int32_t *integer)
+{
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(integer != NULL, "integer argument must be provided");
+	__ASSERT((base >= 2) && (base <= 16), "base must be within 2 and 16");
+
+	/* An empty string has always been parsed as 0 */
+	if (*str == '\0') {
+		*integer = 0;
+		return 0;
+	}
+
+	return lx6_parse_int_bounded(str, base, INT32_MIN, INT32_MAX, integer);
+}
@@ -4,8 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#ifndef ZEPHYR_DRIVERS_GNSS_GNSS_PARSE_H_
-#define ZEPHYR_DRIVERS_GNSS_GNSS_PARSE_H_
+#ifndef ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_PARSE_H_
+#define ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_PARSE_H_
 
 #include <zephyr/types.h>
 
@@ -20,7 +20,7 @@
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if str successfully parsed
  */
-int gnss_parse_dec_to_nano(const char *str, int64_t *nano);
+int lx6_parse_dec_to_nano(const char *str, int64_t *nano);
 
 /**
  * @brief Parse decimal string to micro parts
@@ -33,7 +33,7 @@ int gnss_parse_dec_to_nano(const char *str, int64_t *nano);
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if str successfully parsed
  */
-int gnss_parse_dec_to_micro(const char *str, uint64_t *micro);
+int lx6_parse_dec_to_micro(const char *str, uint64_t *micro);
 
 /**
  * @brief Parse decimal string to milli parts
@@ -46,20 +46,112 @@ int gnss_parse_dec_to_micro(const char *str, uint64_t *micro);
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if str successfully parsed
  */
-int gnss_parse_dec_to_milli(const char *str, int64_t *milli);
+int lx6_parse_dec_to_milli(const char *str, int64_t *milli);
+
+/**
+ * @brief Parse a fixed number of decimal digits to integer
+ *
+ * @details Intended for the fixed width fields of NMEA0183 messages, like the
+ * hours and minutes of hhmmss.sss, which are parsed without any intermediate copy.
+ * Characters following the width digits are ignored.
+ *
+ * @example "1332", 2 -> 13
+ *
+ * @param str String starting with the digits to be parsed
+ * @param width Number of digits to parse, at most 9
+ * @param value Destination for parsed integer
+ *
+ * @retval -EINVAL if str does not start with width decimal digits
+ * @retval 0 if str successfully parsed
+ */
+int lx6_parse_fixed_digits(const char *str, uint8_t width, uint32_t *value);
+
+/**
+ * @brief Parse decimal string to uint8_t within bounds
+ *
+ * @details The string is parsed and bounds checked in a single pass. Signs,
+ * whitespaces and empty strings are rejected.
+ *
+ * @example "42", 0, 90 -> 42
+ *
+ * @param str Decimal string to be parsed
+ * @param min Minimum accepted value
+ * @param max Maximum accepted value
+ * @param value Destination for parsed integer
+ *
+ * @retval -EINVAL if str could not be parsed or is out of bounds
+ * @retval 0 if str successfully parsed
+ */
+int lx6_parse_dec_to_u8(const char *str, uint8_t min, uint8_t max, uint8_t *value);
+
+/**
+ * @brief Parse decimal string to uint16_t within bounds
+ *
+ * @details The string is parsed and bounds checked in a single pass. Signs,
+ * whitespaces and empty strings are rejected.
+ *
+ * @example "359", 0, 359 -> 359
+ *
+ * @param str Decimal string to be parsed
+ * @param min Minimum accepted value
+ * @param max Maximum accepted value
+ * @param value Destination for parsed integer
+ *
+ * @retval -EINVAL if str could not be parsed or is out of bounds
+ * @retval 0 if str successfully parsed
+ */
+int lx6_parse_dec_to_u16(const char *str, uint16_t min, uint16_t max, uint16_t *value);
+
+/**
+ * @brief Parse decimal string to int32_t within bounds
+ *
+ * @details The string is parsed and bounds checked in a single pass. A leading
+ * '-' is accepted, whitespaces and empty strings are rejected.
+ *
+ * @example "-1231", INT32_MIN, INT32_MAX -> -1231
+ *
+ * @param str Decimal string to be parsed
+ * @param min Minimum accepted value
+ * @param max Maximum accepted value
+ * @param value Destination for parsed integer
+ *
+ * @retval -EINVAL if str could not be parsed or is out of bounds
+ * @retval 0 if str successfully parsed
+ */
+int lx6_parse_dec_to_i32(const char *str, int32_t min, int32_t max, int32_t *value);
+
+/**
+ * @brief Parse hexadecimal string to uint8_t within bounds
+ *
+ * @details The string is parsed and bounds checked in a single pass. Both upper
+ * and lower case digits are accepted, prefixes and empty strings are rejected.
+ *
+ * @example "2E", 0, UINT8_MAX -> 46
+ *
+ * @param str Hexadecimal string to be parsed
+ * @param min Minimum accepted value
+ * @param max Maximum accepted value
+ * @param value Destination for parsed integer
+ *
+ * @retval -EINVAL if str could not be parsed or is out of bounds
+ * @retval 0 if str successfully parsed
+ */
+int lx6_parse_hex_to_u8(const char *str, uint8_t min, uint8_t max, uint8_t *value);
 
 /**
  * @brief Parse integer string of configurable base to integer
  *
+ * @details Locale independent, an empty string is parsed as 0.
+ *
  * @example "-1231" -> -1231
  *
  * @param str Decimal string to be parsed
- * @param base Base of decimal string to be parsed
+ * @param base Base of decimal string to be parsed, from 2 to 16
  * @param integer Destination for parsed integer
  *
  * @retval -EINVAL if str could not be parsed
  * @retval 0 if str successfully parsed
  */
-int gnss_parse_atoi(const char *str, uint8_t base, int32_t *integer);
+int lx6_parse_atoi(const char *str, uint8_t base, int32_t *integer);
 
-#endif /* ZEPHYR_DRIVERS_GNSS_GNSS_PARSE_H_ */
+#endif /* ZEPHYR_DRIVERS_GNSS_QUECTEL_LX6_PARSE_H_ */
@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include "gnss_nmea0183.h"
+#include "gnss_parse.h"
+#include "gnss_pmtk_queue.h"
+
+#define GNSS_PMTK_QUEUE_PREFIX      "PMTK"
+#define GNSS_PMTK_QUEUE_PREFIX_SIZE (sizeof(GNSS_PMTK_QUEUE_PREFIX) - 1)
+#define GNSS_PMTK_QUEUE_TYPE_DIGITS (3)
+#define GNSS_PMTK_QUEUE_DELIMITER   "\r\n"
+
+/* Time after which writing is retried once the pipe is full */
+#define GNSS_PMTK_QUEUE_RETRY_MS (10)
+
+/* Flags of $PMTK001 acknowledgement */
+#define GNSS_PMTK_QUEUE_FLAG_INVALID     (0)
+#define GNSS_PMTK_QUEUE_FLAG_UNSUPPORTED (1)
+#define GNSS_PMTK_QUEUE_FLAG_FAILED      (2)
+#define GNSS_PMTK_QUEUE_FLAG_SUCCEEDED   (3)
+
+/* Copy of a completed request, notified once the lock is released */
+struct gnss_pmtk_queue_completion {
+	gnss_pmtk_queue_callback callback;
+	void *user_data;
+	struct k_poll_signal *signal;
+	int result;
+};
+
+static struct gnss_pmtk_queue_request *gnss_pmtk_queue_at(struct gnss_pmtk_queue *queue,
+							   uint8_t offset)
+{
+	return &queue->requests[(queue->head + offset) % queue->requests_size];
+}
+
+/* Must be called with lock held, true once every written request has been completed */
+static bool gnss_pmtk_queue_is_idle(struct gnss_pmtk_queue *queue)
+{
+	if (queue->written_size != 0) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < queue->written; i++) {
+		if (!gnss_pmtk_queue_at(queue, i)->done) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Must be called with lock held, only written requests are completed */
+static void gnss_pmtk_queue_complete(struct gnss_pmtk_queue *queue,
+				     struct gnss_pmtk_queue_request *request, int result,
+				     struct gnss_pmtk_queue_completion *completion)
+{
+	completion->callback = request->callback;
+	completion->user_data = request->user_data;
+	completion->signal = request->signal;
+	completion->result = result;
+	request->done = true;
+
+	/* Requests are completed out of order, free the ones done at head of ring */
+	while ((queue->count > 0) && gnss_pmtk_queue_at(queue, 0)->done) {
+		queue->head = (queue->head + 1) % queue->requests_size;
+		queue->count--;
+		queue->written--;
+	}
+
+	if (queue->paused && gnss_pmtk_queue_is_idle(queue)) {
+		k_sem_give(&queue->idle);
+	}
+}
+
+static void gnss_pmtk_queue_notify(const struct gnss_pmtk_queue *queue,
+				   const struct gnss_pmtk_queue_completion *completion)
+{
+	if (completion->callback != NULL) {
+		completion->callback(queue->gnss, completion->result, completion->user_data);
+	}
+
+#if CONFIG_POLL
+	if (completion->signal != NULL) {
+		k_poll_signal_raise(completion->signal, completion->result);
+	}
+#endif
+}
+
+static int gnss_pmtk_queue_result(uint8_t flag)
+{
+	switch (flag) {
+	case GNSS_PMTK_QUEUE_FLAG_SUCCEEDED:
+		return 0;
+
+	case GNSS_PMTK_QUEUE_FLAG_UNSUPPORTED:
+		return -ENOTSUP;
+
+	case GNSS_PMTK_QUEUE_FLAG_FAILED:
+		return -EIO;
+
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Write requests back-to-back, returns true if the pipe could not take them all */
+static bool gnss_pmtk_queue_write(struct gnss_pmtk_queue *queue)
+{
+	struct gnss_pmtk_queue_completion completion;
+	struct gnss_pmtk_queue_request *request;
+	k_spinlock_key_t key;
+	uint8_t generation;
+	uint8_t offset;
+	int ret;
+
+	while (true) {
+		key = k_spin_lock(&queue->lock);
+
+		/* Once paused, only the request partially written is finished */
+		if (queue->paused && (queue->written_size == 0)) {
+			if (gnss_pmtk_queue_is_idle(queue)) {
+				k_sem_give(&queue->idle);
+			}
+
+			k_spin_unlock(&queue->lock, key);
+			return false;
+		}
+
+		if (queue->written == queue->count) {
+			k_spin_unlock(&queue->lock, key);
+			return false;
+		}
+
+		request = gnss_pmtk_queue_at(queue, queue->written);
+		offset = queue->written_size;
+		generation = queue->generation;
+		k_spin_unlock(&queue->lock, key);
+
+		ret = modem_pipe_transmit(queue->pipe, (const uint8_t *)&request->sentence[offset],
+					  request->size - offset);
+		if (ret == 0) {
+			return true;
+		}
+
+		key = k_spin_lock(&queue->lock);
+
+		if (generation != queue->generation) {
+			k_spin_unlock(&queue->lock, key);
+			continue;
+		}
+
+		if (ret < 0) {
+			queue->written++;
+			queue->written_size = 0;
+			gnss_pmtk_queue_complete(queue, request, ret, &completion);
+			k_spin_unlock(&queue->lock, key);
+			gnss_pmtk_queue_notify(queue, &completion);
+			continue;
+		}
+
+		queue->written_size += ret;
+
+		if (queue->written_size == request->size) {
+			queue->written++;
+			queue->written_size = 0;
+			request->deadline_ms = k_uptime_get() + request->timeout_ms;
+		}
+
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+/* Complete requests not acknowledged in time, returns time until next deadline or -1 */
+static int64_t gnss_pmtk_queue_expire(struct gnss_pmtk_queue *queue)
+{
+	struct gnss_pmtk_queue_completion completion;
+	struct gnss_pmtk_queue_request *request;
+	k_spinlock_key_t key;
+	int64_t remaining;
+	int64_t next;
+	bool expired;
+	int64_t now;
+
+	do {
+		key = k_spin_lock(&queue->lock);
+		now = k_uptime_get();
+		next = -1;
+		expired = false;
+
+		for (uint8_t i = 0; i < queue->written; i++) {
+			request = gnss_pmtk_queue_at(queue, i);
+
+			if (request->done) {
+				continue;
+			}
+
+			remaining = request->deadline_ms - now;
+
+			if (remaining <= 0) {
+				gnss_pmtk_queue_complete(queue, request, -ETIMEDOUT, &completion);
+				expired = true;
+				break;
+			}
+
+			if ((next < 0) || (remaining < next)) {
+				next = remaining;
+			}
+		}
+
+		k_spin_unlock(&queue->lock, key);
+
+		if (expired) {
+			gnss_pmtk_queue_notify(queue, &completion);
+		}
+	} while (expired);
+
+	return next;
+}
+
+static void gnss_pmtk_queue_work_handler(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct gnss_pmtk_queue *queue = CONTAINER_OF(dwork, struct gnss_pmtk_queue, work);
+	bool pending;
+	int64_t delay_ms;
+
+	pending = gnss_pmtk_queue_write(queue);
+	delay_ms = gnss_pmtk_queue_expire(queue);
+
+	if (pending) {
+		delay_ms = (delay_ms < 0) ? GNSS_PMTK_QUEUE_RETRY_MS
+					  : MIN(delay_ms, GNSS_PMTK_QUEUE_RETRY_MS);
+	}
+
+	if (delay_ms >= 0) {
+		(void)k_work_reschedule_for_queue(queue->workq, &queue->work, K_MSEC(delay_ms));
+	}
+}
+
+int gnss_pmtk_queue_init(struct gnss_pmtk_queue *queue,
+			 const struct gnss_pmtk_queue_config *config)
+{
+	__ASSERT(queue != NULL, "queue argument must be provided");
+	__ASSERT(config != NULL, "config argument must be provided");
+
+	if ((config->pipe == NULL) || (config->requests == NULL) ||
+	    (config->requests_size == 0)) {
+		return -EINVAL;
+	}
+
+	memset(queue, 0, sizeof(struct gnss_pmtk_queue));
+	queue->gnss = config->gnss;
+	queue->pipe = config->pipe;
+	queue->workq = (config->workq != NULL) ? config->workq : &k_sys_work_q;
+	queue->requests = config->requests;
+	queue->requests_size = config->requests_size;
+	k_sem_init(&queue->idle, 0, 1);
+	k_work_init_delayable(&queue->work, gnss_pmtk_queue_work_handler);
+	return 0;
+}
+
+int gnss_pmtk_queue_submit(struct gnss_pmtk_queue *queue, const char *command,
+			   uint32_t timeout_ms, gnss_pmtk_queue_callback callback,
+			   void *user_data, struct k_poll_signal *signal)
+{
+	struct gnss_pmtk_queue_request *request;
+	char sentence[GNSS_PMTK_QUEUE_SENTENCE_SIZE];
+	k_spinlock_key_t key;
+	uint32_t type;
+	int ret;
+
+	__ASSERT(command != NULL, "command argument must be provided");
+
+	if (!IS_ENABLED(CONFIG_POLL) && (signal != NULL)) {
+		return -ENOTSUP;
+	}
+
+	if ((strncmp(command, GNSS_PMTK_QUEUE_PREFIX, GNSS_PMTK_QUEUE_PREFIX_SIZE) != 0) ||
+	    (lx6_parse_fixed_digits(&command[GNSS_PMTK_QUEUE_PREFIX_SIZE],
+				    GNSS_PMTK_QUEUE_TYPE_DIGITS, &type) < 0)) {
+		return -EINVAL;
+	}
+
+	/* Leave room for the delimiter */
+	ret = lx6_nmea0183_snprintk(sentence, sizeof(sentence) - 2, "%s", command);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(&sentence[ret], GNSS_PMTK_QUEUE_DELIMITER, sizeof(GNSS_PMTK_QUEUE_DELIMITER));
+
+	key = k_spin_lock(&queue->lock);
+
+	if (queue->count == queue->requests_size) {
+		k_spin_unlock(&queue->lock, key);
+		return -ENOBUFS;
+	}
+
+	request = gnss_pmtk_queue_at(queue, queue->count);
+	memcpy(request->sentence, sentence, ret + 2);
+	request->size = (uint8_t)(ret + 2);
+	request->done = false;
+	request->type = (uint16_t)type;
+	request->timeout_ms = timeout_ms;
+	request->callback = callback;
+	request->user_data = user_data;
+	request->signal = signal;
+	queue->count++;
+
+	k_spin_unlock(&queue->lock, key);
+
+	(void)k_work_reschedule_for_queue(queue->workq, &queue->work, K_NO_WAIT);
+	return 0;
+}
+
+void gnss_pmtk_queue_ack(struct gnss_pmtk_queue *queue, char **argv, uint16_t argc)
+{
+	struct gnss_pmtk_queue_completion completion;
+	struct gnss_pmtk_queue_request *request;
+	k_spinlock_key_t key;
+	bool acked = false;
+	uint16_t type;
+	uint8_t flag;
+
+	/* $PMTK001,<cmd>,<flag>[,<data>...]*<checksum> */
+	if ((argc < 3) || (lx6_parse_dec_to_u16(argv[1], 0, 999, &type) < 0) ||
+	    (lx6_parse_dec_to_u8(argv[2], 0, GNSS_PMTK_QUEUE_FLAG_SUCCEEDED, &flag) < 0)) {
+		return;
+	}
+
+	key = k_spin_lock(&queue->lock);
+
+	/* The module handles commands in order, the oldest one of this type is acknowledged */
+	for (uint8_t i = 0; i < queue->written; i++) {
+		request = gnss_pmtk_queue_at(queue, i);
+
+		if (!request->done && (request->type == type)) {
+			gnss_pmtk_queue_complete(queue, request, gnss_pmtk_queue_result(flag),
+						 &completion);
+			acked = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	if (acked) {
+		gnss_pmtk_queue_notify(queue, &completion);
+	}
+}
+
+int gnss_pmtk_queue_pause(struct gnss_pmtk_queue *queue, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	bool idle;
+
+	key = k_spin_lock(&queue->lock);
+	queue->paused = true;
+	idle = gnss_pmtk_queue_is_idle(queue);
+	k_sem_reset(&queue->idle);
+	k_spin_unlock(&queue->lock, key);
+
+	if (idle) {
+		return 0;
+	}
+
+	(void)k_work_reschedule_for_queue(queue->workq, &queue->work, K_NO_WAIT);
+	return (k_sem_take(&queue->idle, timeout) < 0) ? -EAGAIN : 0;
+}
+
+void gnss_pmtk_queue_resume(struct gnss_pmtk_queue *queue)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&queue->lock);
+	queue->paused = false;
+	k_spin_unlock(&queue->lock, key);
+
+	(void)k_work_reschedule_for_queue(queue->workq, &queue->work, K_NO_WAIT);
+}
+
+void gnss_pmtk_queue_cancel(struct gnss_pmtk_queue *queue)
+{
+	struct gnss_pmtk_queue_completion completion;
+	struct gnss_pmtk_queue_request *request;
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	(void)k_work_cancel_delayable_sync(&queue->work, &sync);
+
+	key = k_spin_lock(&queue->lock);
+	queue->generation++;
+	queue->written_size = 0;
+
+	while (queue->count > 0) {
+		/* Done requests are freed as soon as they reach head */
+		request = gnss_pmtk_queue_at(queue, 0);
+		completion.callback = request->callback;
+		completion.user_data = request->user_data;
+		completion.signal = request->signal;
+		completion.result = -ECANCELED;
+
+		queue->head = (queue->head + 1) % queue->requests_size;
+		queue->count--;
+		queue->written = (queue->written > 0) ? (queue->written - 1) : 0;
+
+		k_spin_unlock(&queue->lock, key);
+		gnss_pmtk_queue_notify(queue, &completion);
+		key = k_spin_lock(&queue->lock);
+	}
+
+	if (queue->paused) {
+		k_sem_give(&queue->idle);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The GNSS PMTK queue sends PMTK commands without waiting for each round trip.
+ *
+ * Commands are copied into a bounded ring of requests and written back-to-back
+ * to the pipe from a work item. Every written command is completed when its
+ * $PMTK001,<cmd>,<flag> acknowledgement is received, or once its timeout
+ * expires. Acknowledgements are handed to gnss_pmtk_queue_ack() by whatever
+ * parses the received sentences, and are matched to the oldest written command
+ * of the same type.
+ *
+ *   const struct gnss_pmtk_queue_config config = {
+ *           .gnss = my_gnss,
+ *           .pipe = my_pipe,
+ *           .requests = my_requests,
+ *           .requests_size = ARRAY_SIZE(my_requests),
+ *   };
+ *
+ *   gnss_pmtk_queue_init(&my_queue, &config);
+ *   ...
+ *   gnss_pmtk_queue_submit(&my_queue, "PMTK220,200", 1000, my_callback, NULL, NULL);
+ *   ...
+ *   gnss_pmtk_queue_ack(&my_queue, argv, argc);
+ *
+ * Commands written by other means, like modem_chat scripts, must not be
+ * interleaved with queued ones. The queue is paused around them, which waits
+ * for written commands to be completed so that their acknowledgements are not
+ * received by the script.
+ */
+
+#ifndef ZEPHYR_DRIVERS_GNSS_GNSS_PMTK_QUEUE_H_
+#define ZEPHYR_DRIVERS_GNSS_GNSS_PMTK_QUEUE_H_
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/modem/pipe.h>
+#include <zephyr/types.h>
+
+/* Longest PMTK314 command with its delimiter fits */
+#define GNSS_PMTK_QUEUE_SENTENCE_SIZE (64)
+
+/**
+ * @brief Callback invoked once a command is completed
+ *
+ * @param gnss GNSS device the command was sent to
+ * @param result 0 if acknowledged as successful, negative errno code otherwise
+ * @param user_data User data given along with the command
+ */
+typedef void (*gnss_pmtk_queue_callback)(const struct device *gnss, int result,
+					 void *user_data);
+
+struct gnss_pmtk_queue_request {
+	char sentence[GNSS_PMTK_QUEUE_SENTENCE_SIZE];
+	uint8_t size;
+	bool done;
+	uint16_t type;
+	uint32_t timeout_ms;
+	int64_t deadline_ms;
+	gnss_pmtk_queue_callback callback;
+	void *user_data;
+	struct k_poll_signal *signal;
+};
+
+struct gnss_pmtk_queue {
+	const struct device *gnss;
+	struct modem_pipe *pipe;
+	struct k_work_q *workq;
+	struct gnss_pmtk_queue_request *requests;
+	uint8_t requests_size;
+	/* Oldest request, and number of requests in ring */
+	uint8_t head;
+	uint8_t count;
+	/* Number of requests written starting from head, and bytes written of the next one */
+	uint8_t written;
+	uint8_t written_size;
+	/* Incremented whenever the ring is cancelled, invalidating the write in progress */
+	uint8_t generation;
+	bool paused;
+	/* Given once paused with every written command completed */
+	struct k_sem idle;
+	struct k_spinlock lock;
+	struct k_work_delayable work;
+};
+
+/** GNSS PMTK queue configuration structure */
+struct gnss_pmtk_queue_config {
+	/** The GNSS device passed to completion callbacks */
+	const struct device *gnss;
+	/** Pipe to which commands are written */
+	struct modem_pipe *pipe;
+	/** Work queue writing commands, NULL for the system work queue */
+	struct k_work_q *workq;
+	/** Buffer for queued requests */
+	struct gnss_pmtk_queue_request *requests;
+	/** Number of elements in buffer for queued requests */
+	uint8_t requests_size;
+};
+
+/**
+ * @brief Initialize a GNSS PMTK queue instance
+ *
+ * @param queue GNSS PMTK queue instance to initialize
+ * @param config Configuration to apply to GNSS PMTK queue instance
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if configuration is invalid
+ */
+int gnss_pmtk_queue_init(struct gnss_pmtk_queue *queue,
+			 const struct gnss_pmtk_queue_config *config);
+
+/**
+ * @brief Queue a PMTK command
+ *
+ * @details The command is completed with 0 if acknowledged as successful,
+ * -EINVAL if invalid, -ENOTSUP if unsupported, -EIO if failed, -ETIMEDOUT if not
+ * acknowledged in time or -ECANCELED if cancelled. Once completed, the callback
+ * is invoked and the signal is raised with the result.
+ *
+ * @param queue GNSS PMTK queue instance
+ * @param command Command without '$' and checksum, like "PMTK220,200"
+ * @param timeout_ms Time allowed for acknowledgement once written
+ * @param callback Callback invoked once completed, may be NULL
+ * @param user_data User data passed to callback
+ * @param signal Signal raised once completed, may be NULL
+ *
+ * @retval 0 if queued
+ * @retval -EINVAL if command is not a PMTK command
+ * @retval -ENOMEM if command is too long
+ * @retval -ENOBUFS if queue is full
+ * @retval -ENOTSUP if a signal is given without CONFIG_POLL
+ */
+int gnss_pmtk_queue_submit(struct gnss_pmtk_queue *queue, const char *command,
+			   uint32_t timeout_ms, gnss_pmtk_queue_callback callback,
+			   void *user_data, struct k_poll_signal *signal);
+
+/**
+ * @brief Complete the command acknowledged by a $PMTK001 sentence
+ *
+ * @param queue GNSS PMTK queue instance
+ * @param argv Fields of $PMTK001 sentence
+ * @param argc Number of fields
+ */
+void gnss_pmtk_queue_ack(struct gnss_pmtk_queue *queue, char **argv, uint16_t argc);
+
+/**
+ * @brief Stop writing commands, waiting for the written ones to be completed
+ *
+ * @details The command being written is finished first. Written commands are
+ * then completed by their acknowledgement or once their timeout expires.
+ *
+ * @param queue GNSS PMTK queue instance
+ * @param timeout Time allowed for written commands to be completed
+ *
+ * @retval 0 if successful
+ * @retval -EAGAIN if written commands could not be completed in time
+ */
+int gnss_pmtk_queue_pause(struct gnss_pmtk_queue *queue, k_timeout_t timeout);
+
+/**
+ * @brief Resume writing commands
+ *
+ * @param queue GNSS PMTK queue instance
+ */
+void gnss_pmtk_queue_resume(struct gnss_pmtk_queue *queue);
+
+/**
+ * @brief Complete all queued commands with -ECANCELED
+ *
+ * @param queue GNSS PMTK queue instance
+ */
+void gnss_pmtk_queue_cancel(struct gnss_pmtk_queue *queue);
+
+#endif /* ZEPHYR_DRIVERS_GNSS_GNSS_PMTK_QUEUE_H_ */
@@ -4,17 +4,26 @@
  */
 #include <zephyr/drivers/gnss.h>
 #include <zephyr/drivers/gnss/gnss_publish.h>
+#include <zephyr/drivers/gnss/quectel_lx6.h>
 #include <zephyr/modem/chat.h>
 #include <zephyr/modem/backend/uart.h>
 #include <zephyr/kernel.h>
 #include <zephyr/pm/device.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/uart.h>
 #include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/math_extras.h>
 #include <string.h>
 
 #include "gnss_nmea0183.h"
 #include "gnss_nmea0183_match.h"
 #include "gnss_parse.h"
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+#include "gnss_nmea0183_framer.h"
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+#include "gnss_pmtk_queue.h"
+#endif
 
 #include <zephyr/logging/log.h>
 
@@ -22,6 +31,13 @@ LOG_MODULE_REGISTER(quectel_lx6, CONFIG_GNSS_LOG_LEVEL);
 
 #define QUECTEL_LX6_PM_TIMEOUT_MS    500U
 #define QUECTEL_LX6_SCRIPT_TIMEOUT_S 10U
+#define QUECTEL_LX6_PROBE_TIMEOUT_S  1U
+
+/* Window over which the rate of received bytes is measured */
+#define QUECTEL_LX6_LINK_WINDOW_MS 1000U
+
+/* Time for PMTK251 to be written before the host UART changes speed */
+#define QUECTEL_LX6_SPEED_SWITCH_MS 100U
 
 #define QUECTEL_LX6_PMTK_NAV_MODE_STATIONARY 4
 #define QUECTEL_LX6_PMTK_NAV_MODE_FITNESS    1
@@ -34,17 +50,130 @@ LOG_MODULE_REGISTER(quectel_lx6, CONFIG_GNSS_LOG_LEVEL);
 #define QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_AFTER_LOCK   1
 #define QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_WHILE_LOCKED 2
 
+#define QUECTEL_LX6_PMTK_POWER_MODE_FULL                 0
+#define QUECTEL_LX6_PMTK_POWER_MODE_PERIODIC_BACKUP      1
+#define QUECTEL_LX6_PMTK_POWER_MODE_PERIODIC_STANDBY     2
+#define QUECTEL_LX6_PMTK_POWER_MODE_ALWAYSLOCATE_STANDBY 8
+#define QUECTEL_LX6_PMTK_POWER_MODE_ALWAYSLOCATE_BACKUP  9
+
+/* AlwaysLocate picks its own sleep times, waking the receiver is given up after this */
+#define QUECTEL_LX6_ALWAYSLOCATE_SLEEP_MAX_MS 60000U
+
+/* PMTK commands, acknowledged with $PMTK001,<command>,<flag> */
+#define QUECTEL_LX6_PMTK_FIX_RATE    220
+#define QUECTEL_LX6_PMTK_POWER_MODE  225
+#define QUECTEL_LX6_PMTK_SPEED       251
+#define QUECTEL_LX6_PMTK_PPS         285
+#define QUECTEL_LX6_PMTK_SBAS        313
+#define QUECTEL_LX6_PMTK_NMEA_OUTPUT 314
+#define QUECTEL_LX6_PMTK_SEARCH_MODE 353
+#define QUECTEL_LX6_PMTK_NAV_MODE    886
+
+/* Restarts are not acknowledged, the receiver outputs its startup system message instead */
+#define QUECTEL_LX6_PMTK_HOT_RESTART    101
+#define QUECTEL_LX6_PMTK_SYSTEM_MESSAGE "$PMTK010"
+#define QUECTEL_LX6_PMTK_STARTUP        "001"
+
+#define QUECTEL_LX6_FIX_INTERVAL_MIN_MS 200
+#define QUECTEL_LX6_FIX_INTERVAL_MAX_MS 1000
+
+/* QZSS can't be set along with the search mode, so it is left out of reported systems too */
+#define QUECTEL_LX6_SUPPORTED_SYSTEMS                                                              \
+	(GNSS_SYSTEM_GPS | GNSS_SYSTEM_GLONASS | GNSS_SYSTEM_GALILEO | GNSS_SYSTEM_BEIDOU |        \
+	 GNSS_SYSTEM_SBAS)
+
+/* A profile is sent as a single batch holding at most one command per PMTK command above */
+#define QUECTEL_LX6_BATCH_SIZE         7
+#define QUECTEL_LX6_BATCH_REQUEST_SIZE 256
+
+/* Fields of PMTK314, output rate of each sentence in number of fixes */
+enum quectel_lx6_pmtk314_field {
+	QUECTEL_LX6_PMTK314_GLL = 0,
+	QUECTEL_LX6_PMTK314_RMC = 1,
+	QUECTEL_LX6_PMTK314_VTG = 2,
+	QUECTEL_LX6_PMTK314_GGA = 3,
+	QUECTEL_LX6_PMTK314_GSA = 4,
+	QUECTEL_LX6_PMTK314_GSV = 5,
+	QUECTEL_LX6_PMTK314_GRS = 6,
+	QUECTEL_LX6_PMTK314_GST = 7,
+	QUECTEL_LX6_PMTK314_ZDA = 17,
+	QUECTEL_LX6_PMTK314_MCHN = 18,
+	QUECTEL_LX6_PMTK314_FIELDS = 19,
+};
+
+/* PMTK314 field of each QUECTEL_LX6_NMEA_* sentence, by bit position */
+static const uint8_t quectel_lx6_pmtk314_fields[QUECTEL_LX6_NMEA_SENTENCES] = {
+	QUECTEL_LX6_PMTK314_GGA, QUECTEL_LX6_PMTK314_RMC, QUECTEL_LX6_PMTK314_GLL,
+	QUECTEL_LX6_PMTK314_VTG, QUECTEL_LX6_PMTK314_ZDA, QUECTEL_LX6_PMTK314_GST,
+	QUECTEL_LX6_PMTK314_GSA, QUECTEL_LX6_PMTK314_GSV,
+};
+
+/* Sentences handled by the driver, the only ones enabled in the output of the receiver */
+#define QUECTEL_LX6_NMEA_OUTPUT                                                                    \
+	((IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA) ? QUECTEL_LX6_NMEA_GGA : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_RMC) ? QUECTEL_LX6_NMEA_RMC : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GLL) ? QUECTEL_LX6_NMEA_GLL : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_VTG) ? QUECTEL_LX6_NMEA_VTG : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_ZDA) ? QUECTEL_LX6_NMEA_ZDA : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GST) ? QUECTEL_LX6_NMEA_GST : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA) ? QUECTEL_LX6_NMEA_GSA : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GSV) ? QUECTEL_LX6_NMEA_GSV : 0))
+
+/* All enabled navigation sentences are required by default */
+#define QUECTEL_LX6_EPOCH_REQUIRED                                                                 \
+	((IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA) ? QUECTEL_LX6_NMEA_GGA : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_RMC) ? QUECTEL_LX6_NMEA_RMC : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GLL) ? QUECTEL_LX6_NMEA_GLL : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_VTG) ? QUECTEL_LX6_NMEA_VTG : 0) |               \
+	 (IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GST) ? QUECTEL_LX6_NMEA_GST : 0))
+
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_INCOMPLETE_PUBLISH
+#define QUECTEL_LX6_EPOCH_POLICY LX6_NMEA0183_MATCH_EPOCH_PUBLISH_PARTIAL
+#else
+#define QUECTEL_LX6_EPOCH_POLICY LX6_NMEA0183_MATCH_EPOCH_DROP
+#endif
+
+BUILD_ASSERT(QUECTEL_LX6_NMEA_GGA == LX6_NMEA0183_MATCH_SENTENCE_GGA);
+BUILD_ASSERT(QUECTEL_LX6_NMEA_RMC == LX6_NMEA0183_MATCH_SENTENCE_RMC);
+BUILD_ASSERT(QUECTEL_LX6_NMEA_GLL == LX6_NMEA0183_MATCH_SENTENCE_GLL);
+BUILD_ASSERT(QUECTEL_LX6_NMEA_VTG == LX6_NMEA0183_MATCH_SENTENCE_VTG);
+BUILD_ASSERT(QUECTEL_LX6_NMEA_ZDA == LX6_NMEA0183_MATCH_SENTENCE_ZDA);
+BUILD_ASSERT(QUECTEL_LX6_NMEA_GST == LX6_NMEA0183_MATCH_SENTENCE_GST);
+BUILD_ASSERT(ARRAY_SIZE(((struct quectel_lx6_latency *)0)->histogram) ==
+	     LX6_NMEA0183_MATCH_LATENCY_BUCKETS);
+
 struct quectel_lx6_config {
 	const struct device *uart;
 	const enum gnss_pps_mode pps_mode;
 	const uint16_t pps_pulse_width;
+	/* Speed the receiver reverts to once power cycled */
+	const uint32_t default_speed;
+	/* Speed negotiated with the receiver, 0 to keep the default one */
+	const uint32_t target_speed;
+	const struct quectel_lx6_power power;
 };
 
 struct quectel_lx6_data {
-	struct gnss_nmea0183_match_data match_data;
-#if CONFIG_GNSS_SATELLITES
+	struct lx6_nmea0183_match_data match_data;
+#if CONFIG_GNSS_SATELLITES && !CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
 	struct gnss_satellite satellites[CONFIG_GNSS_QUECTEL_LX6_SAT_ARRAY_SIZE];
 #endif
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	struct gnss_history history;
+	uint8_t history_buf[CONFIG_GNSS_QUECTEL_LX6_HISTORY_SIZE];
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	sys_slist_t data_callbacks;
+	struct k_mutex data_callbacks_lock;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	sys_slist_t satellite_callbacks;
+	struct k_mutex satellite_callbacks_lock;
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	sys_slist_t satellite_stream_callbacks;
+	struct k_mutex satellite_stream_callbacks_lock;
+#endif
 
 	/* UART backend */
 	struct modem_pipe *uart_pipe;
@@ -58,13 +187,74 @@ struct quectel_lx6_data {
 	uint8_t chat_delimiter[2];
 	uint8_t *chat_argv[32];
 
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	/* NMEA0183 framer */
+	struct lx6_nmea0183_framer framer;
+	char framer_buf[CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER_BUF_SIZE];
+	char *framer_argv[32];
+	uint8_t framer_receive_buf[CONFIG_GNSS_QUECTEL_LX6_UART_RX_BUF_SIZE];
+	uint32_t framer_receive_cycles;
+	struct k_work framer_work;
+	/* Bytes received within the current window, and rate of the last window */
+	uint32_t link_window_start_ms;
+	uint32_t link_window_bytes;
+	uint32_t link_bytes_per_s;
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+	/* Work queue receiving and publishing data */
+	struct k_work_q workq;
+	K_KERNEL_STACK_MEMBER(workq_stack, CONFIG_GNSS_QUECTEL_LX6_WORKQ_STACK_SIZE);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	/* Asynchronous PMTK commands */
+	struct gnss_pmtk_queue pmtk_queue;
+	struct gnss_pmtk_queue_request pmtk_queue_requests[CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE_SIZE];
+#endif
+
+	/* Restart script, only writing the command, and startup reported afterwards */
+	uint8_t restart_request_buf[16];
+	struct modem_chat_script_chat restart_script_chat;
+	struct modem_chat_script restart_script;
+	struct k_sem startup_sem;
+
 	/* Pair chat script */
-	uint8_t pmtk_request_buf[32];
+	uint8_t pmtk_request_buf[64];
 	uint8_t pmtk_match_buf[32];
 	struct modem_chat_match pmtk_match;
 	struct modem_chat_script_chat pmtk_script_chat;
 	struct modem_chat_script pmtk_script;
 
+	/* Batch of PMTK commands sent as a single script */
+	char batch_request_buf[QUECTEL_LX6_BATCH_REQUEST_SIZE];
+	uint16_t batch_request_size;
+	uint8_t batch_size;
+	char batch_match_buf[QUECTEL_LX6_BATCH_SIZE][16];
+	struct modem_chat_match batch_matches[QUECTEL_LX6_BATCH_SIZE];
+	struct modem_chat_script_chat batch_script_chats[QUECTEL_LX6_BATCH_SIZE];
+	struct modem_chat_script batch_script;
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	/* Speed negotiation script */
+	uint8_t speed_request_buf[32];
+	struct modem_chat_script_chat speed_script_chat;
+	struct modem_chat_script speed_script;
+	/* Speed the receiver is expected to run at */
+	uint32_t speed;
+#endif
+
+	/* Settings acknowledged by the receiver, replayed on resume */
+	struct quectel_lx6_profile profile;
+	/* Protects profile, which is only written with the device locked */
+	struct k_spinlock profile_lock;
+	/* Sentences output by the receiver, those of profile which are consumed */
+	uint8_t nmea_output;
+	/* Whether the receiver is configured and accepts commands */
+	bool active;
+	/* Whether the receiver cycles in a power mode, ignoring commands while sleeping */
+	bool power_saving;
+
 	/* Allocation for responses from GNSS modem */
 	union {
 		uint16_t fix_rate_response;
@@ -73,9 +263,42 @@ struct quectel_lx6_data {
 	};
 
 	struct k_sem lock;
+	/* Upper bound of the time until the receiver is ready after a PM action */
 	k_timeout_t pm_timeout;
+	/* Set once the receiver output something since the last PM action */
+	atomic_t pm_ready;
+	struct k_sem pm_ready_sem;
+	struct quectel_lx6_resume_stats resume_stats;
+	struct k_spinlock resume_stats_lock;
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	/* Time to first fix of the last restart, measured until both fixes are received */
+	struct quectel_lx6_ttff_stats ttff_stats[QUECTEL_LX6_RESTARTS];
+	uint32_t ttff_start_ms;
+	uint32_t ttff_hdop;
+	uint8_t ttff_restart;
+	bool ttff_fix_pending;
+	bool ttff_hdop_fix_pending;
+	struct k_spinlock ttff_lock;
+#endif
 };
 
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+MODEM_CHAT_MATCH_DEFINE(pmtk000_success_match, "$PMTK001,0,3*30", "", NULL);
+MODEM_CHAT_SCRIPT_CMDS_DEFINE(probe_script_cmds,
+			      MODEM_CHAT_SCRIPT_CMD_RESP("$PMTK000*32", pmtk000_success_match));
+
+MODEM_CHAT_SCRIPT_NO_ABORT_DEFINE(probe_script, probe_script_cmds, NULL,
+				  QUECTEL_LX6_PROBE_TIMEOUT_S);
+#endif
+
+MODEM_CHAT_MATCH_DEFINE(pmtk225_success_match, "$PMTK001,225,3*35", "", NULL);
+MODEM_CHAT_SCRIPT_CMDS_DEFINE(full_power_script_cmds,
+			      MODEM_CHAT_SCRIPT_CMD_RESP("$PMTK225,0*2B", pmtk225_success_match));
+
+MODEM_CHAT_SCRIPT_NO_ABORT_DEFINE(full_power_script, full_power_script_cmds, NULL,
+				  QUECTEL_LX6_PROBE_TIMEOUT_S);
+
 #ifdef CONFIG_PM_DEVICE
 MODEM_CHAT_MATCH_DEFINE(pmtk161_success_match, "$PMTK001,161,3*36", "", NULL);
 MODEM_CHAT_SCRIPT_CMDS_DEFINE(suspend_script_cmds,
@@ -95,509 +318,2637 @@ MODEM_CHAT_SCRIPT_NO_ABORT_DEFINE(exit_standby_mode_script, exit_standby_mdoe_sc
 				  QUECTEL_LX6_SCRIPT_TIMEOUT_S);
 #endif /* CONFIG_PM_DEVICE */
 
-MODEM_CHAT_SCRIPT_CMDS_DEFINE(
-	resume_script_cmds,
-	MODEM_CHAT_SCRIPT_CMD_RESP("$PMTK314,0,1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0*28",
-				   modem_chat_any_match),
-#if CONFIG_GNSS_SATELLITES
-	MODEM_CHAT_SCRIPT_CMD_RESP("$PMTK314,0,1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0*29",
-				   modem_chat_any_match),
-#endif
-);
+/* Any valid output, like the $PMTK010 system messages, tells the receiver is ready */
+static void quectel_lx6_pm_ready(struct quectel_lx6_data *data)
+{
+	if (atomic_cas(&data->pm_ready, 0, 1)) {
+		k_sem_give(&data->pm_ready_sem);
+	}
+}
 
-MODEM_CHAT_SCRIPT_NO_ABORT_DEFINE(resume_script, resume_script_cmds, NULL,
-				  QUECTEL_LX6_SCRIPT_TIMEOUT_S);
+static void quectel_lx6_nmea_callback(struct modem_chat *chat, char **argv, uint16_t argc,
+				      void *user_data)
+{
+	struct quectel_lx6_data *data = user_data;
 
-MODEM_CHAT_MATCHES_DEFINE(
-	unsol_matches, MODEM_CHAT_MATCH_WILDCARD("$??GGA,", ",*", gnss_nmea0183_match_gga_callback),
-	MODEM_CHAT_MATCH_WILDCARD("$??RMC,", ",*", gnss_nmea0183_match_rmc_callback),
-#if CONFIG_GNSS_SATELLITES
-	MODEM_CHAT_MATCH_WILDCARD("$??GSV,", ",*", gnss_nmea0183_match_gsv_callback),
-#endif
-);
+	quectel_lx6_pm_ready(data);
+	lx6_nmea0183_match_dispatch(&data->match_data, argv, argc);
+}
 
-static int quectel_lx6_configure_pps(const struct device *dev)
+/* $PMTK010,<message>, the startup message completes a restart */
+static void quectel_lx6_system_message(struct quectel_lx6_data *data, char **argv, uint16_t argc)
 {
-	const struct quectel_lx6_config *config = dev->config;
-	struct quectel_lx6_data *data = dev->data;
-	uint8_t pps_mode = 0;
-	int ret;
+	if ((argc > 1) && (strcmp(argv[1], QUECTEL_LX6_PMTK_STARTUP) == 0)) {
+		k_sem_give(&data->startup_sem);
+	}
+}
 
-	switch (config->pps_mode) {
-	case GNSS_PPS_MODE_DISABLED:
-		pps_mode = QUECTEL_LX6_PMTK_PPS_MODE_DISABLED;
-		break;
+static void quectel_lx6_system_message_callback(struct modem_chat *chat, char **argv,
+						uint16_t argc, void *user_data)
+{
+	quectel_lx6_pm_ready(user_data);
+	quectel_lx6_system_message(user_data, argv, argc);
+}
 
-	case GNSS_PPS_MODE_ENABLED:
-		pps_mode = QUECTEL_LX6_PMTK_PPS_MODE_ENABLED;
-		break;
+/* System messages tell readiness, other proprietary $PMTK messages are left to the scripts */
+MODEM_CHAT_MATCHES_DEFINE(unsol_matches,
+			  MODEM_CHAT_MATCH_WILDCARD("$?????,", ",*", quectel_lx6_nmea_callback),
+			  MODEM_CHAT_MATCH("$PMTK010,", ",*", quectel_lx6_system_message_callback));
 
-	case GNSS_PPS_MODE_ENABLED_AFTER_LOCK:
-		pps_mode = QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_AFTER_LOCK;
-		break;
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+#define QUECTEL_LX6_PMTK_ACK "$PMTK001"
+#endif
 
-	case GNSS_PPS_MODE_ENABLED_WHILE_LOCKED:
-		pps_mode = QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_WHILE_LOCKED;
-		break;
-	}
+static void quectel_lx6_framer_callback(const struct lx6_nmea0183_sentence *sentence,
+					void *user_data)
+{
+	struct quectel_lx6_data *data = user_data;
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
-				     "PMTK285,%u,%u", pps_mode, config->pps_pulse_width);
-	if (ret < 0) {
-		return ret;
-	}
+	/* Checksum of the sentence has been verified */
+	quectel_lx6_pm_ready(data);
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
-		return ret;
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	if (strcmp(sentence->argv[0], QUECTEL_LX6_PMTK_ACK) == 0) {
+		gnss_pmtk_queue_ack(&data->pmtk_queue, sentence->argv, sentence->argc);
+		return;
 	}
+#endif
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_match_buf, sizeof(data->pmtk_match_buf),
-				     "PMTK001,285,3");
-	if (ret < 0) {
-		return ret;
+	if (strcmp(sentence->argv[0], QUECTEL_LX6_PMTK_SYSTEM_MESSAGE) == 0) {
+		quectel_lx6_system_message(data, sentence->argv, sentence->argc);
+		return;
 	}
 
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		return ret;
-	}
+	lx6_nmea0183_match_dispatch_timestamped(&data->match_data, sentence->argv, sentence->argc,
+						sentence->timestamp);
+}
 
-	return modem_chat_run_script(&data->chat, &data->pmtk_script);
+static void quectel_lx6_framer_submit(struct quectel_lx6_data *data)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+	k_work_submit_to_queue(&data->workq, &data->framer_work);
+#else
+	k_work_submit(&data->framer_work);
+#endif
 }
 
-static void quectel_lx6_lock(const struct device *dev)
+/* Update the rate of received bytes once per window */
+static void quectel_lx6_link_measure(struct quectel_lx6_data *data)
 {
-	struct quectel_lx6_data *data = dev->data;
+	uint32_t now_ms = k_uptime_get_32();
+	uint32_t elapsed_ms = now_ms - data->link_window_start_ms;
 
-	(void)k_sem_take(&data->lock, K_FOREVER);
+	if (elapsed_ms < QUECTEL_LX6_LINK_WINDOW_MS) {
+		return;
+	}
+
+	/* Rate is read from other threads as a single word */
+	data->link_bytes_per_s = (uint32_t)(((uint64_t)data->link_window_bytes * MSEC_PER_SEC) /
+					    elapsed_ms);
+	data->link_window_start_ms = now_ms;
+	data->link_window_bytes = 0;
 }
 
-static void quectel_lx6_unlock(const struct device *dev)
+static void quectel_lx6_framer_work_handler(struct k_work *item)
 {
-	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_data *data = CONTAINER_OF(item, struct quectel_lx6_data, framer_work);
+	int ret;
 
-	k_sem_give(&data->lock);
+	while (true) {
+		ret = modem_pipe_receive(data->uart_pipe, data->framer_receive_buf,
+					 sizeof(data->framer_receive_buf));
+		if (ret <= 0) {
+			break;
+		}
+
+		lx6_nmea0183_framer_receive(&data->framer, data->framer_receive_buf, (size_t)ret,
+					    data->framer_receive_cycles);
+
+		data->link_window_bytes += (uint32_t)ret;
+	}
+
+	quectel_lx6_link_measure(data);
 }
 
-static void quectel_lx6_pm_changed(const struct device *dev)
+static void quectel_lx6_pipe_callback(struct modem_pipe *pipe, enum modem_pipe_event event,
+				      void *user_data)
 {
-	struct quectel_lx6_data *data = dev->data;
-	uint32_t pm_ready_at_ms;
+	struct quectel_lx6_data *data = user_data;
 
-	pm_ready_at_ms = k_uptime_get() + QUECTEL_LX6_PM_TIMEOUT_MS;
-	data->pm_timeout = K_TIMEOUT_ABS_MS(pm_ready_at_ms);
+	if (event == MODEM_PIPE_EVENT_RECEIVE_READY) {
+		/* Bytes received until the work runs are stamped with the first notification */
+		if (!k_work_is_pending(&data->framer_work)) {
+			data->framer_receive_cycles = k_cycle_get_32();
+		}
+
+		quectel_lx6_framer_submit(data);
+	}
 }
+#endif /* CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER */
 
-static void quectel_lx6_await_pm_ready(const struct device *dev)
+/* Attach the receive path to the pipe, the framer if enabled or modem chat otherwise */
+static int quectel_lx6_attach(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
 
-	LOG_INF("Waiting until PM ready");
-	k_sleep(data->pm_timeout);
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	lx6_nmea0183_framer_reset(&data->framer);
+	modem_pipe_attach(data->uart_pipe, quectel_lx6_pipe_callback, data);
+	quectel_lx6_framer_submit(data);
+	return 0;
+#else
+	return modem_chat_attach(&data->chat, data->uart_pipe);
+#endif
 }
 
-static int quectel_lx6_resume(const struct device *dev)
+/* Run script, handing the pipe over to modem chat for its duration if framer is enabled */
+static int quectel_lx6_run_script(const struct device *dev, const struct modem_chat_script *script)
 {
 	struct quectel_lx6_data *data = dev->data;
 	int ret;
 
-	LOG_INF("Resuming");
-
-	quectel_lx6_await_pm_ready(dev);
-
-	ret = modem_pipe_open(data->uart_pipe, K_SECONDS(10));
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	/* Requests of the script must not be interleaved with queued commands */
+	ret = gnss_pmtk_queue_pause(&data->pmtk_queue, K_SECONDS(QUECTEL_LX6_SCRIPT_TIMEOUT_S));
 	if (ret < 0) {
-		LOG_ERR("Failed to open pipe");
+		gnss_pmtk_queue_resume(&data->pmtk_queue);
 		return ret;
 	}
+#endif
 
-	ret = modem_chat_attach(&data->chat, data->uart_pipe);
-	if (ret < 0) {
-		LOG_ERR("Failed to attach chat");
-		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
-		return ret;
-	}
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	struct k_work_sync sync;
 
-	ret = modem_chat_run_script(&data->chat, &resume_script);
-	if (ret < 0) {
-		LOG_ERR("Failed to initialize GNSS");
-		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
-		return ret;
-	}
+	(void)k_work_cancel_sync(&data->framer_work, &sync);
 
-	ret = quectel_lx6_configure_pps(dev);
-	if (ret < 0) {
-		LOG_ERR("Failed to configure PPS");
-		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
-		return ret;
+	ret = modem_chat_attach(&data->chat, data->uart_pipe);
+	if (ret == 0) {
+		ret = modem_chat_run_script(&data->chat, script);
+		modem_chat_release(&data->chat);
+		(void)quectel_lx6_attach(dev);
 	}
+#else
+	ret = modem_chat_run_script(&data->chat, script);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	gnss_pmtk_queue_resume(&data->pmtk_queue);
+#endif
 
-	LOG_INF("Resumed");
 	return ret;
 }
 
-#ifdef CONFIG_PM_DEVICE
-static int quectel_lx6_suspend(const struct device *dev)
+static uint8_t quectel_lx6_pmtk_pps_mode(enum gnss_pps_mode mode)
 {
-	struct quectel_lx6_data *data = dev->data;
-	int ret;
+	switch (mode) {
+	case GNSS_PPS_MODE_ENABLED:
+		return QUECTEL_LX6_PMTK_PPS_MODE_ENABLED;
 
-	LOG_INF("Suspending: Go to standby mode");
+	case GNSS_PPS_MODE_ENABLED_AFTER_LOCK:
+		return QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_AFTER_LOCK;
 
-	quectel_lx6_await_pm_ready(dev);
+	case GNSS_PPS_MODE_ENABLED_WHILE_LOCKED:
+		return QUECTEL_LX6_PMTK_PPS_MODE_ENABLED_WHILE_LOCKED;
 
-	ret = modem_chat_run_script(&data->chat, &suspend_script);
-	if (ret < 0) {
-		LOG_ERR("Failed to suspend GNSS");
-	} else {
-		LOG_INF("Suspended");
+	default:
+		return QUECTEL_LX6_PMTK_PPS_MODE_DISABLED;
 	}
-
-	return ret;
 }
 
-static void quectel_lx6_turn_on(const struct device *dev)
+static uint8_t quectel_lx6_pmtk_nav_mode(enum gnss_navigation_mode mode)
 {
-	LOG_INF("Powered on");
+	switch (mode) {
+	case GNSS_NAVIGATION_MODE_ZERO_DYNAMICS:
+		return QUECTEL_LX6_PMTK_NAV_MODE_STATIONARY;
+
+	case GNSS_NAVIGATION_MODE_LOW_DYNAMICS:
+		return QUECTEL_LX6_PMTK_NAV_MODE_FITNESS;
+
+	case GNSS_NAVIGATION_MODE_HIGH_DYNAMICS:
+		return QUECTEL_LX6_PMTK_NAV_MODE_AVIATION;
+
+	default:
+		return QUECTEL_LX6_PMTK_NAV_MODE_NORMAL;
+	}
 }
 
-static int quectel_lx6_turn_off(const struct device *dev)
+static uint8_t quectel_lx6_pmtk_power_mode(enum quectel_lx6_power_mode mode)
 {
-	struct quectel_lx6_data *data = dev->data;
+	switch (mode) {
+	case QUECTEL_LX6_POWER_MODE_PERIODIC_STANDBY:
+		return QUECTEL_LX6_PMTK_POWER_MODE_PERIODIC_STANDBY;
 
-	LOG_INF("Powered off");
+	case QUECTEL_LX6_POWER_MODE_PERIODIC_BACKUP:
+		return QUECTEL_LX6_PMTK_POWER_MODE_PERIODIC_BACKUP;
 
-	return modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+	case QUECTEL_LX6_POWER_MODE_ALWAYSLOCATE_STANDBY:
+		return QUECTEL_LX6_PMTK_POWER_MODE_ALWAYSLOCATE_STANDBY;
+
+	case QUECTEL_LX6_POWER_MODE_ALWAYSLOCATE_BACKUP:
+		return QUECTEL_LX6_PMTK_POWER_MODE_ALWAYSLOCATE_BACKUP;
+
+	default:
+		return QUECTEL_LX6_PMTK_POWER_MODE_FULL;
+	}
 }
 
-static int quectel_lx6_exit_standby_mode(const struct device *dev)
+static bool quectel_lx6_power_mode_is_periodic(enum quectel_lx6_power_mode mode)
 {
-	struct quectel_lx6_data *data = dev->data;
+	return (mode == QUECTEL_LX6_POWER_MODE_PERIODIC_STANDBY) ||
+	       (mode == QUECTEL_LX6_POWER_MODE_PERIODIC_BACKUP);
+}
+
+static void quectel_lx6_batch_reset(struct quectel_lx6_data *data)
+{
+	data->batch_request_size = 0;
+	data->batch_size = 0;
+}
+
+/* Append the command formatted in the PMTK request buffer to the batch */
+static int quectel_lx6_batch_append(struct quectel_lx6_data *data, uint16_t command)
+{
+	uint8_t index = data->batch_size;
+	size_t size;
 	int ret;
 
-	LOG_INF("Exit Standby mode");
+	size = strlen((const char *)data->pmtk_request_buf);
 
-	ret = modem_pipe_open(data->uart_pipe, K_SECONDS(10));
-	if (ret < 0) {
-		LOG_ERR("Failed to open pipe");
-		return ret;
+	if ((index == QUECTEL_LX6_BATCH_SIZE) ||
+	    ((data->batch_request_size + size + 2) >= sizeof(data->batch_request_buf))) {
+		return -ENOMEM;
 	}
 
-	ret = modem_chat_attach(&data->chat, data->uart_pipe);
+	/* Commands are delimited like lines, modem chat appends the delimiter of the last one */
+	if (index > 0) {
+		memcpy(&data->batch_request_buf[data->batch_request_size], "\r\n", 2);
+		data->batch_request_size += 2;
+	}
+
+	memcpy(&data->batch_request_buf[data->batch_request_size], data->pmtk_request_buf, size);
+	data->batch_request_size += size;
+	data->batch_request_buf[data->batch_request_size] = '\0';
+
+	ret = snprintk(data->batch_match_buf[index], sizeof(data->batch_match_buf[index]),
+		       "$PMTK001,%u,3", command);
 	if (ret < 0) {
-		LOG_ERR("Failed to attach chat");
-		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
 		return ret;
 	}
 
-	/* Sending any data will make the modules exit Standby mode. */
-	ret = modem_chat_run_script(&data->chat, &exit_standby_mode_script);
+	ret = modem_chat_match_set_match(&data->batch_matches[index], data->batch_match_buf[index]);
 	if (ret < 0) {
-		LOG_ERR("Failed to exit Standby mode GNSS");
-	} else {
-		LOG_INF("Exit Standby mode");
+		return ret;
 	}
 
-	return ret;
+	data->batch_size++;
+	return 0;
 }
 
-static int quectel_lx6_pm_action(const struct device *dev, enum pm_device_action action)
+/* Output interval of a sentence of the NMEA output in number of fixes */
+static uint8_t quectel_lx6_nmea_interval(const uint8_t *intervals, uint8_t index)
 {
-	int ret = -ENOTSUP;
+	return MAX(intervals[index], 1);
+}
 
-	quectel_lx6_lock(dev);
+/* Sentences of the NMEA output which are not output every fix */
+static uint8_t quectel_lx6_nmea_decimated(const struct quectel_lx6_profile *profile)
+{
+	uint8_t decimated = 0;
 
-	switch (action) {
-	case PM_DEVICE_ACTION_SUSPEND:
-		ret = quectel_lx6_suspend(dev);
-		break;
+	for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+		if ((profile->nmea_output & BIT(i)) &&
+		    (quectel_lx6_nmea_interval(profile->nmea_intervals, i) > 1)) {
+			decimated |= BIT(i);
+		}
+	}
 
-	case PM_DEVICE_ACTION_RESUME:
-		ret = quectel_lx6_exit_standby_mode(dev);
-		break;
+	return decimated;
+}
 
-	case PM_DEVICE_ACTION_TURN_ON:
-		quectel_lx6_turn_on(dev);
-		ret = 0;
-		break;
+static int quectel_lx6_batch_nmea_output(struct quectel_lx6_data *data, uint8_t sentences,
+					 const uint8_t *intervals)
+{
+	uint8_t rates[QUECTEL_LX6_PMTK314_FIELDS] = {0};
+	char fields[(QUECTEL_LX6_PMTK314_FIELDS * 2) + 1];
+	int ret;
 
-	case PM_DEVICE_ACTION_TURN_OFF:
-		ret = quectel_lx6_turn_off(dev);
-		break;
+	for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+		if (sentences & BIT(i)) {
+			rates[quectel_lx6_pmtk314_fields[i]] =
+				quectel_lx6_nmea_interval(intervals, i);
+		}
+	}
 
-	default:
-		break;
+	/* Rates range from 0 to 5, a single digit each */
+	for (uint8_t i = 0; i < QUECTEL_LX6_PMTK314_FIELDS; i++) {
+		fields[i * 2] = ',';
+		fields[(i * 2) + 1] = (char)('0' + rates[i]);
 	}
 
-	quectel_lx6_pm_changed(dev);
+	fields[QUECTEL_LX6_PMTK314_FIELDS * 2] = '\0';
 
-	quectel_lx6_unlock(dev);
-	return ret;
+	ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+				    "PMTK%u%s", QUECTEL_LX6_PMTK_NMEA_OUTPUT, fields);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_NMEA_OUTPUT);
 }
-#endif /* CONFIG_PM_DEVICE */
 
-static int quectel_lx6_set_fix_rate(const struct device *dev, uint32_t fix_interval_ms)
+static int quectel_lx6_batch_power_mode(struct quectel_lx6_data *data,
+					const struct quectel_lx6_power *power)
 {
-	struct quectel_lx6_data *data = dev->data;
+	uint8_t mode = quectel_lx6_pmtk_power_mode(power->mode);
 	int ret;
 
-	if (fix_interval_ms < 200 || fix_interval_ms > 1000) {
-		return -EINVAL;
+	if (quectel_lx6_power_mode_is_periodic(power->mode)) {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u,%u,%u,%u,%u", QUECTEL_LX6_PMTK_POWER_MODE,
+					    mode, power->run_ms, power->sleep_ms,
+					    power->second_run_ms, power->second_sleep_ms);
+	} else {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u", QUECTEL_LX6_PMTK_POWER_MODE, mode);
 	}
 
-	quectel_lx6_lock(dev);
-
-	ret = gnss_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
-				     "PMTK220,%u", fix_interval_ms);
 	if (ret < 0) {
-		goto unlock_return;
+		return ret;
 	}
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+	return quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_POWER_MODE);
+}
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_match_buf, sizeof(data->pmtk_match_buf),
-				     "PMTK001,220,3,%u", fix_interval_ms);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+/* Append the commands applying the settings staged in profile */
+static int quectel_lx6_batch_profile(struct quectel_lx6_data *data,
+				     const struct quectel_lx6_profile *profile)
+{
+	gnss_systems_t systems = profile->systems;
+	int ret;
 
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		goto unlock_return;
+	if (profile->settings & QUECTEL_LX6_PROFILE_NMEA_OUTPUT) {
+		ret = quectel_lx6_batch_nmea_output(data, profile->nmea_output,
+						    profile->nmea_intervals);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
-	ret = modem_chat_run_script(&data->chat, &data->pmtk_script);
-	if (ret < 0) {
+	if (profile->settings & QUECTEL_LX6_PROFILE_FIX_RATE) {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u", QUECTEL_LX6_PMTK_FIX_RATE,
+					    profile->fix_interval_ms);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_FIX_RATE);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_NAVIGATION_MODE) {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u", QUECTEL_LX6_PMTK_NAV_MODE,
+					    quectel_lx6_pmtk_nav_mode(profile->navigation_mode));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_NAV_MODE);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_SYSTEMS) {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u,%u,%u,0,%u", QUECTEL_LX6_PMTK_SEARCH_MODE,
+					    (0 < (systems & GNSS_SYSTEM_GPS)),
+					    (0 < (systems & GNSS_SYSTEM_GLONASS)),
+					    (0 < (systems & GNSS_SYSTEM_GALILEO)),
+					    (0 < (systems & GNSS_SYSTEM_BEIDOU)));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_SEARCH_MODE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u", QUECTEL_LX6_PMTK_SBAS,
+					    (0 < (systems & GNSS_SYSTEM_SBAS)));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_SBAS);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_PPS) {
+		ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+					    "PMTK%u,%u,%u", QUECTEL_LX6_PMTK_PPS,
+					    quectel_lx6_pmtk_pps_mode(profile->pps_mode),
+					    profile->pps_pulse_width);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_batch_append(data, QUECTEL_LX6_PMTK_PPS);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	/* Last, as the receiver may fall asleep as soon as it is acknowledged */
+	if (profile->settings & QUECTEL_LX6_PROFILE_POWER_MODE) {
+		ret = quectel_lx6_batch_power_mode(data, &profile->power);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Write all commands of the batch at once, then await their acknowledgements in
+ * order, so the batch takes a single round trip.
+ */
+static int quectel_lx6_batch_run(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int ret;
+
+	if (data->batch_size == 0) {
+		return 0;
+	}
+
+	ret = modem_chat_script_chat_set_request(&data->batch_script_chats[0],
+						 data->batch_request_buf);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (uint8_t i = 1; i < data->batch_size; i++) {
+		ret = modem_chat_script_chat_set_request(&data->batch_script_chats[i], "");
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	modem_chat_script_set_script_chats(&data->batch_script, data->batch_script_chats,
+					   data->batch_size);
+
+	return quectel_lx6_run_script(dev, &data->batch_script);
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSV
+/* Whether any callback consumes the satellites parsed from GSV sentences */
+static bool quectel_lx6_satellites_consumed(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	bool consumed = false;
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	/* Sky views are only forwarded to satellite stream callbacks */
+	k_mutex_lock(&data->satellite_stream_callbacks_lock, K_FOREVER);
+	consumed = !sys_slist_is_empty(&data->satellite_stream_callbacks);
+	k_mutex_unlock(&data->satellite_stream_callbacks_lock);
+#else
+	STRUCT_SECTION_FOREACH(gnss_satellites_callback, callback) {
+		if ((callback->dev == NULL) || (callback->dev == dev)) {
+			return true;
+		}
+	}
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	k_mutex_lock(&data->satellite_callbacks_lock, K_FOREVER);
+	consumed = !sys_slist_is_empty(&data->satellite_callbacks);
+	k_mutex_unlock(&data->satellite_callbacks_lock);
+#else
+	ARG_UNUSED(data);
+#endif
+#endif
+
+	return consumed;
+}
+#endif
+
+/* Leave out of sentences those nobody consumes */
+static uint8_t quectel_lx6_consumed_nmea_output(const struct device *dev, uint8_t sentences)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSV
+	if (!quectel_lx6_satellites_consumed(dev)) {
+		sentences &= ~QUECTEL_LX6_NMEA_GSV;
+	}
+#endif
+
+	return sentences;
+}
+
+/* Whether profile makes the receiver cycle in a power mode */
+static bool quectel_lx6_power_saving(const struct quectel_lx6_profile *profile)
+{
+	return (profile->settings & QUECTEL_LX6_PROFILE_POWER_MODE) &&
+	       (profile->power.mode != QUECTEL_LX6_POWER_MODE_FULL);
+}
+
+/* Replay the settings applied to the receiver */
+static int quectel_lx6_configure(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_profile profile = data->profile;
+	int ret;
+
+	profile.nmea_output = quectel_lx6_consumed_nmea_output(dev, profile.nmea_output);
+
+	quectel_lx6_batch_reset(data);
+
+	ret = quectel_lx6_batch_profile(data, &profile);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = quectel_lx6_batch_run(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->nmea_output = profile.nmea_output;
+	data->active = true;
+	data->power_saving = quectel_lx6_power_saving(&profile);
+	return 0;
+}
+
+/* Longest time the receiver may sleep in its power mode */
+static uint32_t quectel_lx6_power_sleep_max_ms(const struct quectel_lx6_power *power)
+{
+	if (quectel_lx6_power_mode_is_periodic(power->mode)) {
+		return MAX(power->sleep_ms, power->second_sleep_ms);
+	}
+
+	return QUECTEL_LX6_ALWAYSLOCATE_SLEEP_MAX_MS;
+}
+
+/*
+ * Bring the receiver back to full power so it accepts commands, must be called
+ * with the device locked. Standby modes wake up on the first command, while
+ * backup modes only accept it once running again, so it is repeated until then.
+ */
+static int quectel_lx6_wake(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int64_t deadline_ms;
+	int ret;
+
+	if (!data->power_saving) {
+		return 0;
+	}
+
+	LOG_INF("Waking up from power mode");
+
+	deadline_ms = k_uptime_get() + quectel_lx6_power_sleep_max_ms(&data->profile.power);
+
+	do {
+		ret = quectel_lx6_run_script(dev, &full_power_script);
+	} while ((ret < 0) && (k_uptime_get() < deadline_ms));
+
+	if (ret < 0) {
+		LOG_ERR("Failed to wake up from power mode");
+		return ret;
+	}
+
+	data->power_saving = false;
+	return 0;
+}
+
+/* Restore the power mode once woken up, must be called with the device locked */
+static int quectel_lx6_restore_power_mode(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int ret;
+
+	if (data->power_saving || !quectel_lx6_power_saving(&data->profile)) {
+		return 0;
+	}
+
+	quectel_lx6_batch_reset(data);
+
+	ret = quectel_lx6_batch_power_mode(data, &data->profile.power);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = quectel_lx6_batch_run(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->power_saving = true;
+	return 0;
+}
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+/* Change the speed of the host UART, the pipe must be closed */
+static int quectel_lx6_configure_host_speed(const struct device *dev, uint32_t speed)
+{
+	const struct quectel_lx6_config *config = dev->config;
+	struct uart_config uart_config;
+	int ret;
+
+	ret = uart_config_get(config->uart, &uart_config);
+	if ((ret < 0) || (uart_config.baudrate == speed)) {
+		return ret;
+	}
+
+	uart_config.baudrate = speed;
+	return uart_configure(config->uart, &uart_config);
+}
+
+/* Check whether the receiver responds at speed, reopening the pipe at it if needed */
+static int quectel_lx6_probe_speed(const struct device *dev, uint32_t speed)
+{
+	const struct quectel_lx6_config *config = dev->config;
+	struct quectel_lx6_data *data = dev->data;
+	struct uart_config uart_config;
+	int ret;
+
+	ret = uart_config_get(config->uart, &uart_config);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (uart_config.baudrate != speed) {
+		ret = modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+		if (ret < 0) {
+			return ret;
+		}
+
+		uart_config.baudrate = speed;
+		ret = uart_configure(config->uart, &uart_config);
+		if (ret < 0) {
+			LOG_ERR("Failed to configure UART at %u baud", speed);
+			return ret;
+		}
+
+		ret = modem_pipe_open(data->uart_pipe, K_SECONDS(10));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = quectel_lx6_attach(dev);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return quectel_lx6_run_script(dev, &probe_script);
+}
+
+/*
+ * Switch the receiver to speed with PMTK251, which is not acknowledged, then
+ * check that it responds at that speed. Otherwise the speed it last responded
+ * at is kept, and -EIO is returned if the receiver still responds at it.
+ */
+static int quectel_lx6_switch_speed(const struct device *dev, uint32_t speed)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int ret;
+
+	ret = lx6_nmea0183_snprintk(data->speed_request_buf, sizeof(data->speed_request_buf),
+				    "PMTK%u,%u", QUECTEL_LX6_PMTK_SPEED, speed);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = modem_chat_script_chat_set_request(&data->speed_script_chat,
+						 data->speed_request_buf);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = quectel_lx6_run_script(dev, &data->speed_script);
+	if (ret == 0) {
+		ret = quectel_lx6_probe_speed(dev, speed);
+	}
+
+	if (ret == 0) {
+		LOG_INF("Switched to %u baud", speed);
+		data->speed = speed;
+		return 0;
+	}
+
+	LOG_WRN("Failed to switch to %u baud, falling back to %u baud", speed, data->speed);
+
+	ret = quectel_lx6_probe_speed(dev, data->speed);
+	return (ret < 0) ? ret : -EIO;
+}
+
+/* Find the speed the receiver responds at, then switch it to the target speed */
+static int quectel_lx6_negotiate_speed(const struct device *dev)
+{
+	const struct quectel_lx6_config *config = dev->config;
+	struct quectel_lx6_data *data = dev->data;
+	uint32_t speed;
+	int ret;
+
+	if (config->target_speed == 0) {
+		return 0;
+	}
+
+	/* Receiver reverts to its default speed if it has been power cycled behind our back */
+	ret = quectel_lx6_probe_speed(dev, data->speed);
+	if (ret < 0) {
+		speed = (data->speed == config->target_speed) ? config->default_speed
+							       : config->target_speed;
+
+		ret = quectel_lx6_probe_speed(dev, speed);
+		if (ret < 0) {
+			LOG_ERR("Receiver not responding");
+			return ret;
+		}
+
+		data->speed = speed;
+	}
+
+	if (data->speed == config->target_speed) {
+		return 0;
+	}
+
+	/* Receiver is still usable at the speed it fell back to */
+	ret = quectel_lx6_switch_speed(dev, config->target_speed);
+	return (ret == -EIO) ? 0 : ret;
+}
+#endif
+
+static void quectel_lx6_lock(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+}
+
+static void quectel_lx6_unlock(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	k_sem_give(&data->lock);
+}
+
+static void quectel_lx6_pm_changed(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	uint32_t pm_ready_at_ms;
+
+	pm_ready_at_ms = k_uptime_get() + QUECTEL_LX6_PM_TIMEOUT_MS;
+	data->pm_timeout = K_TIMEOUT_ABS_MS(pm_ready_at_ms);
+
+	/* Semaphore is reset first, so output received in between is not lost */
+	k_sem_reset(&data->pm_ready_sem);
+	atomic_clear(&data->pm_ready);
+}
+
+/* Wait until the receiver outputs something, at most until the PM timeout */
+static void quectel_lx6_await_pm_ready(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+	uint32_t start_ms;
+	bool timed_out;
+
+	if (atomic_get(&data->pm_ready) != 0) {
+		return;
+	}
+
+	LOG_INF("Waiting until PM ready");
+
+	start_ms = k_uptime_get_32();
+	timed_out = k_sem_take(&data->pm_ready_sem, data->pm_timeout) < 0;
+
+	key = k_spin_lock(&data->resume_stats_lock);
+	data->resume_stats.last_ready_wait_ms = k_uptime_get_32() - start_ms;
+	if (timed_out) {
+		data->resume_stats.ready_timeouts++;
+	}
+	k_spin_unlock(&data->resume_stats_lock, key);
+}
+
+/* Record the time taken by a successful resume */
+static void quectel_lx6_resumed(const struct device *dev, uint32_t start_ms)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_resume_stats *stats = &data->resume_stats;
+	uint32_t resume_ms = k_uptime_get_32() - start_ms;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->resume_stats_lock);
+	stats->count++;
+	stats->last_ms = resume_ms;
+	stats->max_ms = MAX(stats->max_ms, resume_ms);
+	stats->total_ms += resume_ms;
+	k_spin_unlock(&data->resume_stats_lock, key);
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+/* Start measuring the time to first fix, abandoning the measurement in progress */
+static void quectel_lx6_ttff_start(const struct device *dev, enum quectel_lx6_restart restart)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->ttff_lock);
+	data->ttff_start_ms = k_uptime_get_32();
+	data->ttff_restart = restart;
+	data->ttff_fix_pending = true;
+	data->ttff_hdop_fix_pending = true;
+	data->ttff_stats[restart].restarts++;
+	k_spin_unlock(&data->ttff_lock, key);
+}
+
+static void quectel_lx6_ttff_record(struct quectel_lx6_ttff *ttff, uint32_t ttff_ms)
+{
+	ttff->min_ms = (ttff->count == 0) ? ttff_ms : MIN(ttff->min_ms, ttff_ms);
+	ttff->max_ms = MAX(ttff->max_ms, ttff_ms);
+	ttff->total_ms += ttff_ms;
+	ttff->count++;
+}
+
+static void quectel_lx6_ttff_fix(const struct device *dev, const struct gnss_data *gnss_data)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_ttff_stats *stats;
+	k_spinlock_key_t key;
+	uint32_t ttff_ms;
+
+	if (gnss_data->info.fix_status == GNSS_FIX_STATUS_NO_FIX) {
+		return;
+	}
+
+	key = k_spin_lock(&data->ttff_lock);
+
+	stats = &data->ttff_stats[data->ttff_restart];
+	ttff_ms = k_uptime_get_32() - data->ttff_start_ms;
+
+	if (data->ttff_fix_pending) {
+		quectel_lx6_ttff_record(&stats->fix, ttff_ms);
+		data->ttff_fix_pending = false;
+	}
+
+	/* HDOP is only reported by GGA sentences, the measurement is skipped without them */
+	if (!(data->nmea_output & QUECTEL_LX6_NMEA_GGA)) {
+		data->ttff_hdop_fix_pending = false;
+	}
+
+	if (data->ttff_hdop_fix_pending && (gnss_data->info.hdop <= data->ttff_hdop)) {
+		quectel_lx6_ttff_record(&stats->hdop_fix, ttff_ms);
+		data->ttff_hdop_fix_pending = false;
+	}
+
+	k_spin_unlock(&data->ttff_lock, key);
+}
+#endif
+
+static int quectel_lx6_resume(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	uint32_t start_ms = k_uptime_get_32();
+	int ret;
+
+	LOG_INF("Resuming");
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	quectel_lx6_ttff_start(dev, QUECTEL_LX6_RESTART_RESUME);
+#endif
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	ret = quectel_lx6_configure_host_speed(dev, data->speed);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure UART");
+		return ret;
+	}
+#endif
+
+	ret = modem_pipe_open(data->uart_pipe, K_SECONDS(10));
+	if (ret < 0) {
+		LOG_ERR("Failed to open pipe");
+		return ret;
+	}
+
+	ret = quectel_lx6_attach(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to attach chat");
+		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+		return ret;
+	}
+
+	/* Pipe is open so that the output of the receiver tells once it is ready */
+	quectel_lx6_await_pm_ready(dev);
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	ret = quectel_lx6_negotiate_speed(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to negotiate speed");
+		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+		return ret;
+	}
+#endif
+
+	ret = quectel_lx6_configure(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure");
+		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+		return ret;
+	}
+
+	quectel_lx6_resumed(dev, start_ms);
+
+	LOG_INF("Resumed");
+	return ret;
+}
+
+#ifdef CONFIG_PM_DEVICE
+static int quectel_lx6_suspend(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int ret;
+
+	LOG_INF("Suspending: Go to standby mode");
+
+	quectel_lx6_await_pm_ready(dev);
+
+	/* Power mode is restored along with the other settings once resumed */
+	ret = quectel_lx6_wake(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = quectel_lx6_run_script(dev, &suspend_script);
+	if (ret < 0) {
+		LOG_ERR("Failed to suspend GNSS");
+	} else {
+		data->active = false;
+		LOG_INF("Suspended");
+	}
+
+	return ret;
+}
+
+static void quectel_lx6_turn_on(const struct device *dev)
+{
+	LOG_INF("Powered on");
+}
+
+static int quectel_lx6_turn_off(const struct device *dev)
+{
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	const struct quectel_lx6_config *config = dev->config;
+#endif
+	struct quectel_lx6_data *data = dev->data;
+
+	LOG_INF("Powered off");
+
+	data->active = false;
+	/* Receiver is back at full power once powered on */
+	data->power_saving = false;
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	/* Receiver reverts to its default speed once powered back on */
+	data->speed = config->default_speed;
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	gnss_pmtk_queue_cancel(&data->pmtk_queue);
+#endif
+
+	return modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+}
+
+static int quectel_lx6_exit_standby_mode(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	uint32_t start_ms = k_uptime_get_32();
+	int ret;
+
+	LOG_INF("Exit Standby mode");
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	quectel_lx6_ttff_start(dev, QUECTEL_LX6_RESTART_RESUME);
+#endif
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	ret = quectel_lx6_configure_host_speed(dev, data->speed);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure UART");
+		return ret;
+	}
+#endif
+
+	ret = modem_pipe_open(data->uart_pipe, K_SECONDS(10));
+	if (ret < 0) {
+		LOG_ERR("Failed to open pipe");
+		return ret;
+	}
+
+	ret = quectel_lx6_attach(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to attach chat");
+		modem_pipe_close(data->uart_pipe, K_SECONDS(10));
+		return ret;
+	}
+
+	/* Sending any data will make the modules exit Standby mode. */
+	ret = quectel_lx6_run_script(dev, &exit_standby_mode_script);
+	if (ret < 0) {
+		LOG_ERR("Failed to exit Standby mode GNSS");
+		return ret;
+	}
+
+	LOG_INF("Exit Standby mode");
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	ret = quectel_lx6_negotiate_speed(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to negotiate speed");
+		return ret;
+	}
+#endif
+
+	ret = quectel_lx6_configure(dev);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure");
+		return ret;
+	}
+
+	quectel_lx6_resumed(dev, start_ms);
+	return 0;
+}
+
+static int quectel_lx6_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	int ret = -ENOTSUP;
+
+	quectel_lx6_lock(dev);
+
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+		ret = quectel_lx6_suspend(dev);
+		break;
+
+	case PM_DEVICE_ACTION_RESUME:
+		ret = quectel_lx6_exit_standby_mode(dev);
+		break;
+
+	case PM_DEVICE_ACTION_TURN_ON:
+		quectel_lx6_turn_on(dev);
+		ret = 0;
+		break;
+
+	case PM_DEVICE_ACTION_TURN_OFF:
+		ret = quectel_lx6_turn_off(dev);
+		break;
+
+	default:
+		break;
+	}
+
+	quectel_lx6_pm_changed(dev);
+
+	/* Receiver acknowledged its configuration, it is ready already */
+	if ((action == PM_DEVICE_ACTION_RESUME) && (ret == 0)) {
+		quectel_lx6_pm_ready(dev->data);
+	}
+
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+#endif /* CONFIG_PM_DEVICE */
+
+static void quectel_lx6_merge_profile(struct quectel_lx6_profile *profile,
+				      const struct quectel_lx6_profile *staged)
+{
+	if (staged->settings & QUECTEL_LX6_PROFILE_FIX_RATE) {
+		profile->fix_interval_ms = staged->fix_interval_ms;
+	}
+
+	if (staged->settings & QUECTEL_LX6_PROFILE_NAVIGATION_MODE) {
+		profile->navigation_mode = staged->navigation_mode;
+	}
+
+	if (staged->settings & QUECTEL_LX6_PROFILE_SYSTEMS) {
+		profile->systems = staged->systems;
+	}
+
+	if (staged->settings & QUECTEL_LX6_PROFILE_PPS) {
+		profile->pps_mode = staged->pps_mode;
+		profile->pps_pulse_width = staged->pps_pulse_width;
+	}
+
+	if (staged->settings & QUECTEL_LX6_PROFILE_NMEA_OUTPUT) {
+		profile->nmea_output = staged->nmea_output;
+		memcpy(profile->nmea_intervals, staged->nmea_intervals,
+		       sizeof(profile->nmea_intervals));
+	}
+
+	if (staged->settings & QUECTEL_LX6_PROFILE_POWER_MODE) {
+		profile->power = staged->power;
+	}
+
+	profile->settings |= staged->settings;
+}
+
+/* Systems enabled by the receiver until configured otherwise */
+#define QUECTEL_LX6_DEFAULT_SYSTEMS (GNSS_SYSTEM_GPS | GNSS_SYSTEM_GLONASS)
+/* Fix interval of the receiver until configured otherwise */
+#define QUECTEL_LX6_DEFAULT_FIX_INTERVAL_MS 1000U
+
+/* GSA is output once per system, GSV up to 3 times per system with 4 satellites each */
+#define QUECTEL_LX6_GSV_PER_SYSTEM 3U
+
+/* Bits per byte on the UART, start and stop bits included */
+#define QUECTEL_LX6_LINK_BITS_PER_BYTE 10U
+
+/* Longest sentence of each QUECTEL_LX6_NMEA_* type, delimiter included, by bit position */
+static const uint8_t quectel_lx6_nmea_sizes[QUECTEL_LX6_NMEA_SENTENCES] = {
+	78, /* GGA */
+	74, /* RMC */
+	51, /* GLL */
+	43, /* VTG */
+	39, /* ZDA */
+	72, /* GST */
+	69, /* GSA */
+	70, /* GSV */
+};
+
+/* Speed of the link to the receiver in baud */
+static uint32_t quectel_lx6_link_speed(const struct device *dev)
+{
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	struct quectel_lx6_data *data = dev->data;
+
+	return data->speed;
+#else
+	const struct quectel_lx6_config *config = dev->config;
+
+	return config->default_speed;
+#endif
+}
+
+/* Worst case number of bytes per second output by the receiver configured with profile */
+static uint32_t quectel_lx6_link_bytes_per_s(const struct quectel_lx6_profile *profile)
+{
+	gnss_systems_t systems = QUECTEL_LX6_DEFAULT_SYSTEMS;
+	uint32_t fix_interval_ms = QUECTEL_LX6_DEFAULT_FIX_INTERVAL_MS;
+	uint32_t systems_count;
+	uint32_t bytes_per_s = 0;
+	uint32_t count;
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_SYSTEMS) {
+		systems = profile->systems;
+	}
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_FIX_RATE) {
+		fix_interval_ms = profile->fix_interval_ms;
+	}
+
+	/* SBAS satellites are reported along with GPS ones */
+	systems_count = MAX(POPCOUNT(systems & ~GNSS_SYSTEM_SBAS), 1);
+
+	for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+		if ((profile->nmea_output & BIT(i)) == 0) {
+			continue;
+		}
+
+		count = 1;
+
+		if (BIT(i) == QUECTEL_LX6_NMEA_GSA) {
+			count = systems_count;
+		} else if (BIT(i) == QUECTEL_LX6_NMEA_GSV) {
+			count = systems_count * QUECTEL_LX6_GSV_PER_SYSTEM;
+		}
+
+		bytes_per_s += (quectel_lx6_nmea_sizes[i] * count * MSEC_PER_SEC) /
+			       (fix_interval_ms *
+				quectel_lx6_nmea_interval(profile->nmea_intervals, i));
+	}
+
+	return bytes_per_s;
+}
+
+/* Share of the link used by bytes_per_s, in percent */
+static uint32_t quectel_lx6_link_utilization(const struct device *dev, uint32_t bytes_per_s)
+{
+	return (bytes_per_s * QUECTEL_LX6_LINK_BITS_PER_BYTE * 100U) / quectel_lx6_link_speed(dev);
+}
+
+static bool quectel_lx6_power_time_valid(uint32_t time_ms)
+{
+	return IN_RANGE(time_ms, QUECTEL_LX6_POWER_TIME_MIN_MS, QUECTEL_LX6_POWER_TIME_MAX_MS);
+}
+
+static bool quectel_lx6_power_valid(const struct quectel_lx6_power *power)
+{
+	if (power->mode > QUECTEL_LX6_POWER_MODE_ALWAYSLOCATE_BACKUP) {
+		return false;
+	}
+
+	if (!quectel_lx6_power_mode_is_periodic(power->mode)) {
+		return true;
+	}
+
+	if (!quectel_lx6_power_time_valid(power->run_ms) ||
+	    !quectel_lx6_power_time_valid(power->sleep_ms)) {
+		return false;
+	}
+
+	/* Second cycle is either disabled or fully defined */
+	if ((power->second_run_ms == 0) && (power->second_sleep_ms == 0)) {
+		return true;
+	}
+
+	return quectel_lx6_power_time_valid(power->second_run_ms) &&
+	       quectel_lx6_power_time_valid(power->second_sleep_ms);
+}
+
+int quectel_lx6_validate_profile(const struct device *dev,
+				 const struct quectel_lx6_profile *profile)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_profile merged;
+	uint32_t applied_bytes_per_s;
+	uint32_t bytes_per_s;
+	k_spinlock_key_t key;
+	uint8_t required;
+
+	if ((profile->settings & ~QUECTEL_LX6_PROFILE_ALL) != 0) {
+		return -EINVAL;
+	}
+
+	if ((profile->settings & QUECTEL_LX6_PROFILE_FIX_RATE) &&
+	    ((profile->fix_interval_ms < QUECTEL_LX6_FIX_INTERVAL_MIN_MS) ||
+	     (profile->fix_interval_ms > QUECTEL_LX6_FIX_INTERVAL_MAX_MS))) {
+		return -EINVAL;
+	}
+
+	if ((profile->settings & QUECTEL_LX6_PROFILE_NAVIGATION_MODE) &&
+	    (profile->navigation_mode > GNSS_NAVIGATION_MODE_HIGH_DYNAMICS)) {
+		return -EINVAL;
+	}
+
+	/* SBAS only augments the other systems */
+	if ((profile->settings & QUECTEL_LX6_PROFILE_SYSTEMS) &&
+	    (((profile->systems & ~QUECTEL_LX6_SUPPORTED_SYSTEMS) != 0) ||
+	     ((profile->systems & ~GNSS_SYSTEM_SBAS) == 0))) {
+		return -EINVAL;
+	}
+
+	if ((profile->settings & QUECTEL_LX6_PROFILE_PPS) &&
+	    (profile->pps_mode > GNSS_PPS_MODE_ENABLED_WHILE_LOCKED)) {
+		return -EINVAL;
+	}
+
+	if ((profile->settings & QUECTEL_LX6_PROFILE_POWER_MODE) &&
+	    !quectel_lx6_power_valid(&profile->power)) {
+		return -EINVAL;
+	}
+
+	/* Epochs could never be completed without their required sentences */
+	required = lx6_nmea0183_match_get_epoch_required(&data->match_data);
+
+	if (profile->settings & QUECTEL_LX6_PROFILE_NMEA_OUTPUT) {
+		if (((profile->nmea_output & ~QUECTEL_LX6_NMEA_OUTPUT) != 0) ||
+		    ((profile->nmea_output & required) != required)) {
+			return -EINVAL;
+		}
+
+		for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+			if (profile->nmea_intervals[i] > QUECTEL_LX6_NMEA_INTERVAL_MAX) {
+				return -EINVAL;
+			}
+		}
+
+		/* Epochs are completed by the required sentences output every fix */
+		if ((required & ~quectel_lx6_nmea_decimated(profile)) == 0) {
+			return -EINVAL;
+		}
+	}
+
+	if (CONFIG_GNSS_QUECTEL_LX6_LINK_BUDGET == 0) {
+		return 0;
+	}
+
+	key = k_spin_lock(&data->profile_lock);
+	merged = data->profile;
+	k_spin_unlock(&data->profile_lock, key);
+
+	applied_bytes_per_s = quectel_lx6_link_bytes_per_s(&merged);
+	quectel_lx6_merge_profile(&merged, profile);
+	bytes_per_s = quectel_lx6_link_bytes_per_s(&merged);
+
+	/*
+	 * Sentences lost to an overrun link would go unnoticed. Settings which don't
+	 * increase the output are accepted, even if it already exceeds the budget.
+	 */
+	if ((bytes_per_s > applied_bytes_per_s) &&
+	    (quectel_lx6_link_utilization(dev, bytes_per_s) >
+	     CONFIG_GNSS_QUECTEL_LX6_LINK_BUDGET)) {
+		return -ENOSPC;
+	}
+
+	return 0;
+}
+
+/* Whether two profiles make the receiver output the same sentences at the same intervals */
+static bool quectel_lx6_nmea_output_equal(const struct quectel_lx6_profile *a,
+					  const struct quectel_lx6_profile *b)
+{
+	if (a->nmea_output != b->nmea_output) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+		if ((a->nmea_output & BIT(i)) &&
+		    (quectel_lx6_nmea_interval(a->nmea_intervals, i) !=
+		     quectel_lx6_nmea_interval(b->nmea_intervals, i))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Whether two power modes are the same, times only matter to periodic modes */
+static bool quectel_lx6_power_equal(const struct quectel_lx6_power *a,
+				    const struct quectel_lx6_power *b)
+{
+	if (a->mode != b->mode) {
+		return false;
+	}
+
+	if (!quectel_lx6_power_mode_is_periodic(a->mode)) {
+		return true;
+	}
+
+	return (a->run_ms == b->run_ms) && (a->sleep_ms == b->sleep_ms) &&
+	       (a->second_run_ms == b->second_run_ms) &&
+	       (a->second_sleep_ms == b->second_sleep_ms);
+}
+
+/* Get the staged settings which differ from the applied ones */
+static uint8_t quectel_lx6_profile_changes(const struct quectel_lx6_profile *profile,
+					   const struct quectel_lx6_profile *staged)
+{
+	uint8_t changes = staged->settings & ~profile->settings;
+	uint8_t applied = staged->settings & profile->settings;
+
+	if ((applied & QUECTEL_LX6_PROFILE_FIX_RATE) &&
+	    (staged->fix_interval_ms != profile->fix_interval_ms)) {
+		changes |= QUECTEL_LX6_PROFILE_FIX_RATE;
+	}
+
+	if ((applied & QUECTEL_LX6_PROFILE_NAVIGATION_MODE) &&
+	    (staged->navigation_mode != profile->navigation_mode)) {
+		changes |= QUECTEL_LX6_PROFILE_NAVIGATION_MODE;
+	}
+
+	if ((applied & QUECTEL_LX6_PROFILE_SYSTEMS) && (staged->systems != profile->systems)) {
+		changes |= QUECTEL_LX6_PROFILE_SYSTEMS;
+	}
+
+	if ((applied & QUECTEL_LX6_PROFILE_PPS) &&
+	    ((staged->pps_mode != profile->pps_mode) ||
+	     (staged->pps_pulse_width != profile->pps_pulse_width))) {
+		changes |= QUECTEL_LX6_PROFILE_PPS;
+	}
+
+	if ((applied & QUECTEL_LX6_PROFILE_NMEA_OUTPUT) &&
+	    !quectel_lx6_nmea_output_equal(staged, profile)) {
+		changes |= QUECTEL_LX6_PROFILE_NMEA_OUTPUT;
+	}
+
+	if ((applied & QUECTEL_LX6_PROFILE_POWER_MODE) &&
+	    !quectel_lx6_power_equal(&staged->power, &profile->power)) {
+		changes |= QUECTEL_LX6_PROFILE_POWER_MODE;
+	}
+
+	return changes;
+}
+
+/* Apply a validated profile with the device locked */
+static int quectel_lx6_apply(const struct device *dev, const struct quectel_lx6_profile *profile)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_profile changed;
+	struct quectel_lx6_profile sent;
+	k_spinlock_key_t key;
+	int ret;
+
+	/* Settings already applied are not sent again */
+	changed = *profile;
+	changed.settings = quectel_lx6_profile_changes(&data->profile, profile);
+	if (changed.settings == 0) {
+		return 0;
+	}
+
+	sent = changed;
+	sent.nmea_output = quectel_lx6_consumed_nmea_output(dev, changed.nmea_output);
+
+	/* Commands would be lost while the receiver sleeps, its power mode is restored last */
+	if (data->power_saving) {
+		ret = quectel_lx6_wake(dev);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (!(sent.settings & QUECTEL_LX6_PROFILE_POWER_MODE)) {
+			sent.settings |= QUECTEL_LX6_PROFILE_POWER_MODE;
+			sent.power = data->profile.power;
+		}
+	}
+
+	quectel_lx6_batch_reset(data);
+
+	ret = quectel_lx6_batch_profile(data, &sent);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = quectel_lx6_batch_run(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (sent.settings & QUECTEL_LX6_PROFILE_NMEA_OUTPUT) {
+		data->nmea_output = sent.nmea_output;
+		lx6_nmea0183_match_set_epoch_decimated(&data->match_data,
+						       quectel_lx6_nmea_decimated(&changed));
+	}
+
+	if (sent.settings & QUECTEL_LX6_PROFILE_POWER_MODE) {
+		data->power_saving = quectel_lx6_power_saving(&sent);
+	}
+
+	key = k_spin_lock(&data->profile_lock);
+	quectel_lx6_merge_profile(&data->profile, &changed);
+	k_spin_unlock(&data->profile_lock, key);
+	return 0;
+}
+
+int quectel_lx6_apply_profile(const struct device *dev, const struct quectel_lx6_profile *profile)
+{
+	int ret;
+
+	/* Validated with the device locked, so the required sentences can't change meanwhile */
+	quectel_lx6_lock(dev);
+
+	ret = quectel_lx6_validate_profile(dev, profile);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+	ret = quectel_lx6_apply(dev, profile);
+
+unlock_return:
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+int quectel_lx6_get_profile(const struct device *dev, struct quectel_lx6_profile *profile)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->profile_lock);
+	*profile = data->profile;
+	k_spin_unlock(&data->profile_lock, key);
+	return 0;
+}
+
+static int quectel_lx6_set_fix_rate(const struct device *dev, uint32_t fix_interval_ms)
+{
+	const struct quectel_lx6_profile profile = {
+		.settings = QUECTEL_LX6_PROFILE_FIX_RATE,
+		.fix_interval_ms = fix_interval_ms,
+	};
+
+	return quectel_lx6_apply_profile(dev, &profile);
+}
+
+/* Can't be queried with the specification protocol v2.2, only applied value is known */
+static int quectel_lx6_get_fix_rate(const struct device *dev, uint32_t *fix_interval_ms)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+	int ret = -ENODATA;
+
+	key = k_spin_lock(&data->profile_lock);
+
+	if (data->profile.settings & QUECTEL_LX6_PROFILE_FIX_RATE) {
+		*fix_interval_ms = data->profile.fix_interval_ms;
+		ret = 0;
+	}
+
+	k_spin_unlock(&data->profile_lock, key);
+	return ret;
+}
+
+static int quectel_lx6_set_navigation_mode(const struct device *dev, enum gnss_navigation_mode mode)
+{
+	const struct quectel_lx6_profile profile = {
+		.settings = QUECTEL_LX6_PROFILE_NAVIGATION_MODE,
+		.navigation_mode = mode,
+	};
+
+	return quectel_lx6_apply_profile(dev, &profile);
+}
+
+/* Can't be queried with the specification protocol v2.2, only applied value is known */
+static int quectel_lx6_get_navigation_mode(const struct device *dev,
+					   enum gnss_navigation_mode *mode)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+	int ret = -ENODATA;
+
+	key = k_spin_lock(&data->profile_lock);
+
+	if (data->profile.settings & QUECTEL_LX6_PROFILE_NAVIGATION_MODE) {
+		*mode = data->profile.navigation_mode;
+		ret = 0;
+	}
+
+	k_spin_unlock(&data->profile_lock, key);
+	return ret;
+}
+
+static int quectel_lx6_set_enabled_systems(const struct device *dev, gnss_systems_t systems)
+{
+	const struct quectel_lx6_profile profile = {
+		.settings = QUECTEL_LX6_PROFILE_SYSTEMS,
+		.systems = systems,
+	};
+
+	return quectel_lx6_apply_profile(dev, &profile);
+}
+
+static inline bool search_mode_enabled(const char *arg)
+{
+	return arg[0] == '1';
+}
+
+static void quectel_lx6_get_search_mode_callback(struct modem_chat *chat, char **argv,
+						 uint16_t argc, void *user_data)
+{
+	struct quectel_lx6_data *data = user_data;
+
+	if (argc != 8) {
+		return;
+	}
+
+	data->enabled_systems_response = search_mode_enabled(argv[1]) ? GNSS_SYSTEM_GPS : 0;
+	data->enabled_systems_response |= search_mode_enabled(argv[2]) ? GNSS_SYSTEM_GLONASS : 0;
+	data->enabled_systems_response |= search_mode_enabled(argv[3]) ? GNSS_SYSTEM_GALILEO : 0;
+	data->enabled_systems_response |= search_mode_enabled(argv[4]) ? GNSS_SYSTEM_BEIDOU : 0;
+	data->enabled_systems_response |= search_mode_enabled(argv[5]) ? GNSS_SYSTEM_QZSS : 0;
+}
+
+/* Query systems enabled in the receiver, must be called with the device locked */
+static int quectel_lx6_query_enabled_systems(const struct device *dev, gnss_systems_t *systems)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int restore_ret;
+	int ret;
+
+	ret = quectel_lx6_wake(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = lx6_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
+				    "PMTK355");
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
+	if (ret < 0) {
+		return ret;
+	}
+
+	strncpy(data->pmtk_match_buf, "$PMTK001,355,3", sizeof(data->pmtk_match_buf));
+	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
+	if (ret < 0) {
+		return ret;
+	}
+
+	modem_chat_match_set_callback(&data->pmtk_match, quectel_lx6_get_search_mode_callback);
+	ret = quectel_lx6_run_script(dev, &data->pmtk_script);
+	modem_chat_match_set_callback(&data->pmtk_match, NULL);
+
+	/* Power mode is restored even if the query failed */
+	restore_ret = quectel_lx6_restore_power_mode(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (restore_ret < 0) {
+		return restore_ret;
+	}
+
+	/* get SBAS system: not supported in protocol specification v2.2 */
+	*systems = data->enabled_systems_response & QUECTEL_LX6_SUPPORTED_SYSTEMS;
+	return 0;
+}
+
+static int quectel_lx6_get_enabled_systems(const struct device *dev, gnss_systems_t *systems)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+	bool cached;
+	int ret;
+
+	key = k_spin_lock(&data->profile_lock);
+	cached = (data->profile.settings & QUECTEL_LX6_PROFILE_SYSTEMS) != 0;
+	*systems = data->profile.systems;
+	k_spin_unlock(&data->profile_lock, key);
+
+	if (cached) {
+		return 0;
+	}
+
+	quectel_lx6_lock(dev);
+	ret = quectel_lx6_query_enabled_systems(dev, systems);
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+int quectel_lx6_refresh_profile(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	gnss_systems_t systems;
+	k_spinlock_key_t key;
+	int ret;
+
+	quectel_lx6_lock(dev);
+
+	ret = quectel_lx6_query_enabled_systems(dev, &systems);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+	/*
+	 * SBAS can't be queried, so systems which were never applied are not cached,
+	 * as replaying them would also change SBAS.
+	 */
+	key = k_spin_lock(&data->profile_lock);
+
+	if (data->profile.settings & QUECTEL_LX6_PROFILE_SYSTEMS) {
+		data->profile.systems = systems | (data->profile.systems & GNSS_SYSTEM_SBAS);
+	}
+
+	k_spin_unlock(&data->profile_lock, key);
+
+unlock_return:
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+static int quectel_lx6_get_supported_systems(const struct device *dev, gnss_systems_t *systems)
+{
+	*systems = QUECTEL_LX6_SUPPORTED_SYSTEMS;
+	return 0;
+}
+
+int quectel_lx6_get_latest_fix(const struct device *dev, struct gnss_data *latest)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	return lx6_nmea0183_match_get_latest(&data->match_data, latest);
+}
+
+int quectel_lx6_get_dop(const struct device *dev, struct quectel_lx6_dop *dop)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+	struct quectel_lx6_data *data = dev->data;
+	struct lx6_nmea0183_dop nmea_dop;
+	int ret;
+
+	ret = lx6_nmea0183_match_get_dop(&data->match_data, &nmea_dop);
+	if (ret < 0) {
+		return ret;
+	}
+
+	dop->pdop = nmea_dop.pdop;
+	dop->hdop = nmea_dop.hdop;
+	dop->vdop = nmea_dop.vdop;
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+bool quectel_lx6_satellite_is_used(const struct device *dev,
+				   const struct gnss_satellite *satellite)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	return lx6_nmea0183_match_is_used(&data->match_data, satellite);
+}
+
+int quectel_lx6_get_accuracy(const struct device *dev, struct quectel_lx6_accuracy *accuracy)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	struct quectel_lx6_data *data = dev->data;
+	struct lx6_nmea0183_gst gst;
+	int ret;
+
+	ret = lx6_nmea0183_match_get_gst(&data->match_data, &gst);
+	if (ret < 0) {
+		return ret;
+	}
+
+	accuracy->latitude_stddev = gst.latitude_stddev;
+	accuracy->longitude_stddev = gst.longitude_stddev;
+	accuracy->altitude_stddev = gst.altitude_stddev;
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_set_accuracy_gate(const struct device *dev, uint32_t horizontal_stddev_mm)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+	struct quectel_lx6_data *data = dev->data;
+
+	lx6_nmea0183_match_set_accuracy_gate(&data->match_data, horizontal_stddev_mm);
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_set_epoch_required(const struct device *dev, uint8_t sentences)
+{
+	struct quectel_lx6_data *data = dev->data;
+	int ret = -EINVAL;
+
+	quectel_lx6_lock(dev);
+
+	/* Like when applying the NMEA output, epochs must remain completable */
+	if (((sentences & ~data->profile.nmea_output) != 0) ||
+	    ((sentences & ~quectel_lx6_nmea_decimated(&data->profile)) == 0)) {
+		goto unlock_return;
+	}
+
+	ret = lx6_nmea0183_match_set_epoch_required(&data->match_data, sentences);
+
+unlock_return:
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+int quectel_lx6_set_nmea_interval(const struct device *dev, uint8_t sentences, uint8_t fixes)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_profile profile;
+	int ret;
+
+	if ((sentences == 0) || ((sentences & ~QUECTEL_LX6_NMEA_OUTPUT) != 0) ||
+	    (fixes > QUECTEL_LX6_NMEA_INTERVAL_MAX)) {
+		return -EINVAL;
+	}
+
+	quectel_lx6_lock(dev);
+
+	/* Intervals of other sentences are kept */
+	profile = data->profile;
+	profile.settings = QUECTEL_LX6_PROFILE_NMEA_OUTPUT;
+
+	if (fixes == 0) {
+		profile.nmea_output &= ~sentences;
+	} else {
+		profile.nmea_output |= sentences;
+	}
+
+	for (uint8_t i = 0; i < QUECTEL_LX6_NMEA_SENTENCES; i++) {
+		if (sentences & BIT(i)) {
+			profile.nmea_intervals[i] = fixes;
+		}
+	}
+
+	ret = quectel_lx6_validate_profile(dev, &profile);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+	ret = quectel_lx6_apply(dev, &profile);
+
+unlock_return:
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+int quectel_lx6_get_link_budget(const struct device *dev, struct quectel_lx6_link_budget *budget)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	struct quectel_lx6_data *data = dev->data;
+#endif
+	struct quectel_lx6_profile profile;
+
+	(void)quectel_lx6_get_profile(dev, &profile);
+
+	budget->speed = quectel_lx6_link_speed(dev);
+	budget->estimated_bytes_per_s = quectel_lx6_link_bytes_per_s(&profile);
+	budget->estimated_utilization =
+		quectel_lx6_link_utilization(dev, budget->estimated_bytes_per_s);
+	budget->measured_bytes_per_s = 0;
+
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	/* Windows are only closed as bytes are received, an idle link is measured as such */
+	if ((k_uptime_get_32() - data->link_window_start_ms) < (2 * QUECTEL_LX6_LINK_WINDOW_MS)) {
+		budget->measured_bytes_per_s = data->link_bytes_per_s;
+	}
+#endif
+
+	budget->measured_utilization =
+		quectel_lx6_link_utilization(dev, budget->measured_bytes_per_s);
+	return 0;
+}
+
+int quectel_lx6_get_nmea_interval(const struct device *dev, uint8_t sentence, uint8_t *fixes)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+	uint8_t index;
+
+	if (!IS_POWER_OF_TWO(sentence)) {
+		return -EINVAL;
+	}
+
+	index = (uint8_t)u32_count_trailing_zeros(sentence);
+
+	key = k_spin_lock(&data->profile_lock);
+	*fixes = (data->profile.nmea_output & sentence)
+			 ? quectel_lx6_nmea_interval(data->profile.nmea_intervals, index)
+			 : 0;
+	k_spin_unlock(&data->profile_lock, key);
+	return 0;
+}
+
+int quectel_lx6_set_power_mode(const struct device *dev, const struct quectel_lx6_power *power)
+{
+	const struct quectel_lx6_profile profile = {
+		.settings = QUECTEL_LX6_PROFILE_POWER_MODE,
+		.power = *power,
+	};
+
+	return quectel_lx6_apply_profile(dev, &profile);
+}
+
+int quectel_lx6_get_power_mode(const struct device *dev, struct quectel_lx6_power *power)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->profile_lock);
+
+	/* Receiver powers up at full power */
+	if (data->profile.settings & QUECTEL_LX6_PROFILE_POWER_MODE) {
+		*power = data->profile.power;
+	} else {
+		memset(power, 0, sizeof(*power));
+		power->mode = QUECTEL_LX6_POWER_MODE_FULL;
+	}
+
+	k_spin_unlock(&data->profile_lock, key);
+	return 0;
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+static void quectel_lx6_copy_latency(struct quectel_lx6_latency *latency,
+				     const struct lx6_nmea0183_match_latency *match_latency)
+{
+	latency->count = match_latency->count;
+	latency->min_us = match_latency->min_us;
+	latency->max_us = match_latency->max_us;
+	latency->total_us = match_latency->total_us;
+	memcpy(latency->histogram, match_latency->histogram, sizeof(latency->histogram));
+}
+#endif
+
+int quectel_lx6_get_epoch_stats(const struct device *dev, struct quectel_lx6_epoch_stats *stats)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct lx6_nmea0183_match_epoch_stats match_stats;
+	int ret;
+
+	ret = lx6_nmea0183_match_get_epoch_stats(&data->match_data, &match_stats);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	stats->complete = match_stats.complete;
+	stats->partial = match_stats.partial;
+	stats->dropped = match_stats.dropped;
+	stats->gated = match_stats.gated;
+#if CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS
+	quectel_lx6_copy_latency(&stats->assembly, &match_stats.assembly);
+	quectel_lx6_copy_latency(&stats->publish, &match_stats.publish);
+#endif
+	return 0;
+}
+
+void quectel_lx6_reset_epoch_stats(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	lx6_nmea0183_match_reset_epoch_stats(&data->match_data);
+}
+
+int quectel_lx6_get_resume_stats(const struct device *dev, struct quectel_lx6_resume_stats *stats)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->resume_stats_lock);
+	*stats = data->resume_stats;
+	k_spin_unlock(&data->resume_stats_lock, key);
+
+	return 0;
+}
+
+void quectel_lx6_reset_resume_stats(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->resume_stats_lock);
+	memset(&data->resume_stats, 0, sizeof(data->resume_stats));
+	k_spin_unlock(&data->resume_stats_lock, key);
+}
+
+/* Replay all settings once the receiver was reset to its factory settings */
+static int quectel_lx6_reconfigure(const struct device *dev)
+{
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	int ret;
+
+	ret = quectel_lx6_negotiate_speed(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
+	return quectel_lx6_configure(dev);
+}
+
+int quectel_lx6_restart(const struct device *dev, enum quectel_lx6_restart restart)
+{
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	const struct quectel_lx6_config *config = dev->config;
+#endif
+	struct quectel_lx6_data *data = dev->data;
+	int ret;
+
+	if ((uint32_t)restart >= QUECTEL_LX6_RESTART_RESUME) {
+		return -EINVAL;
+	}
+
+	quectel_lx6_lock(dev);
+
+	/* Command would be lost while the receiver sleeps */
+	ret = quectel_lx6_wake(dev);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	/* Receiver reports its startup from a full cold restart at its default speed */
+	if ((restart == QUECTEL_LX6_RESTART_FULL_COLD) && (data->speed != config->default_speed)) {
+		ret = quectel_lx6_switch_speed(dev, config->default_speed);
+		if (ret < 0) {
+			goto unlock_return;
+		}
+
+		/* Startup would be missed at any other speed */
+		if (data->speed != config->default_speed) {
+			ret = -EIO;
+			goto unlock_return;
+		}
+	}
+#endif
+
+	ret = lx6_nmea0183_snprintk(data->restart_request_buf, sizeof(data->restart_request_buf),
+				    "PMTK%u", QUECTEL_LX6_PMTK_HOT_RESTART + restart);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+	ret = modem_chat_script_chat_set_request(&data->restart_script_chat,
+						 data->restart_request_buf);
+	if (ret < 0) {
+		goto unlock_return;
+	}
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	quectel_lx6_ttff_start(dev, restart);
+#endif
+
+	/*
+	 * Startup message is also matched by the unsolicited matches, which would
+	 * win over a script response, so it is awaited from the system message
+	 */
+	k_sem_reset(&data->startup_sem);
+
+	ret = quectel_lx6_run_script(dev, &data->restart_script);
+	if (ret == 0) {
+		ret = k_sem_take(&data->startup_sem, K_SECONDS(QUECTEL_LX6_SCRIPT_TIMEOUT_S));
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to restart");
+		goto unlock_return;
+	}
+
+	/*
+	 * Other restarts keep the settings, the power mode is restored in case it
+	 * was left. The speed the receiver responds at is probed again either way.
+	 */
+	if (restart == QUECTEL_LX6_RESTART_FULL_COLD) {
+		ret = quectel_lx6_reconfigure(dev);
+	} else {
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+		ret = quectel_lx6_negotiate_speed(dev);
+		if (ret == 0) {
+			ret = quectel_lx6_restore_power_mode(dev);
+		}
+#else
+		ret = quectel_lx6_restore_power_mode(dev);
+#endif
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to configure");
+	}
+
+unlock_return:
+	quectel_lx6_unlock(dev);
+	return ret;
+}
+
+int quectel_lx6_get_ttff_stats(const struct device *dev, enum quectel_lx6_restart restart,
+			       struct quectel_lx6_ttff_stats *stats)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	if ((uint32_t)restart >= QUECTEL_LX6_RESTARTS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&data->ttff_lock);
+	*stats = data->ttff_stats[restart];
+	k_spin_unlock(&data->ttff_lock, key);
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+void quectel_lx6_reset_ttff_stats(const struct device *dev)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->ttff_lock);
+	memset(data->ttff_stats, 0, sizeof(data->ttff_stats));
+	k_spin_unlock(&data->ttff_lock, key);
+#endif
+}
+
+int quectel_lx6_set_ttff_hdop(const struct device *dev, uint32_t hdop)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	struct quectel_lx6_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->ttff_lock);
+	data->ttff_hdop = hdop;
+	k_spin_unlock(&data->ttff_lock, key);
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+/* Fixes are drained in batches to bound stack usage */
+#define QUECTEL_LX6_HISTORY_BATCH_SIZE 4
+
+static void quectel_lx6_copy_fix(struct quectel_lx6_fix *fix,
+				 const struct gnss_history_fix *history_fix)
+{
+	fix->timestamp_ms = history_fix->timestamp_ms;
+	fix->latitude = history_fix->latitude;
+	fix->longitude = history_fix->longitude;
+	fix->altitude = history_fix->altitude;
+	fix->speed = history_fix->speed;
+	fix->bearing = history_fix->bearing;
+}
+
+struct quectel_lx6_history_visitor {
+	quectel_lx6_history_visit_t visit;
+	void *user_data;
+};
+
+static bool quectel_lx6_history_visit(const struct gnss_history_fix *history_fix,
+				      void *user_data)
+{
+	struct quectel_lx6_history_visitor *visitor = user_data;
+	struct quectel_lx6_fix fix;
+
+	quectel_lx6_copy_fix(&fix, history_fix);
+	return visitor->visit(&fix, visitor->user_data);
+}
+#endif
+
+int quectel_lx6_history_drain(const struct device *dev, struct quectel_lx6_fix *fixes,
+			      size_t size)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	struct quectel_lx6_data *data = dev->data;
+	struct gnss_history_fix batch[QUECTEL_LX6_HISTORY_BATCH_SIZE];
+	size_t drained = 0;
+	size_t count;
+
+	while (drained < size) {
+		count = gnss_history_drain(&data->history, batch,
+					   MIN(size - drained, ARRAY_SIZE(batch)));
+		if (count == 0) {
+			break;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			quectel_lx6_copy_fix(&fixes[drained++], &batch[i]);
+		}
+	}
+
+	return (int)drained;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_history_foreach(const struct device *dev, quectel_lx6_history_visit_t visit,
+				void *user_data)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_history_visitor visitor = {
+		.visit = visit,
+		.user_data = user_data,
+	};
+
+	return (int)gnss_history_foreach(&data->history, quectel_lx6_history_visit, &visitor);
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_get_workq_stack_usage(const struct device *dev, size_t *used, size_t *size)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ && CONFIG_INIT_STACKS && CONFIG_THREAD_STACK_INFO
+	struct quectel_lx6_data *data = dev->data;
+	size_t unused;
+	int ret;
+
+	ret = k_thread_stack_space_get(&data->workq.thread, &unused);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*size = data->workq.thread.stack_info.size;
+	*used = *size - unused;
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_pmtk_submit(const struct device *dev, const char *command, uint32_t timeout_ms,
+			    quectel_lx6_pmtk_handler_t handler, void *user_data,
+			    struct k_poll_signal *signal)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	struct quectel_lx6_data *data = dev->data;
+
+	return gnss_pmtk_queue_submit(&data->pmtk_queue, command, timeout_ms, handler, user_data,
+				      signal);
+#else
+	return -ENOTSUP;
+#endif
+}
+
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+#define QUECTEL_LX6_NANO_DEGREES      (1000000000LL)
+/* Length of a thousandth of a degree along a meridian, in millimeters */
+#define QUECTEL_LX6_MM_PER_MILLIDEGREE (111320LL)
+#define QUECTEL_LX6_COS_STEP          (10 * QUECTEL_LX6_NANO_DEGREES)
+
+/* Cosine in Q15, every 10 degrees from 0 to 90 degrees */
+static const uint16_t quectel_lx6_cos_q15[] = {
+	32768, 32270, 30792, 28378, 25102, 21063, 16384, 11207, 5690, 0,
+};
+
+static uint64_t quectel_lx6_abs(int64_t value)
+{
+	return (value < 0) ? (uint64_t)-value : (uint64_t)value;
+}
+
+/* Cosine of latitude in Q15, linearly interpolated within 0.4% */
+static uint32_t quectel_lx6_cos_q15_of(int64_t latitude)
+{
+	uint64_t angle = MIN(quectel_lx6_abs(latitude), 90 * QUECTEL_LX6_NANO_DEGREES);
+	uint32_t index = (uint32_t)(angle / QUECTEL_LX6_COS_STEP);
+	uint64_t remainder = angle % QUECTEL_LX6_COS_STEP;
+
+	if (index >= (ARRAY_SIZE(quectel_lx6_cos_q15) - 1)) {
+		return 0;
+	}
+
+	return quectel_lx6_cos_q15[index] -
+	       (uint32_t)(((uint64_t)(quectel_lx6_cos_q15[index] - quectel_lx6_cos_q15[index + 1]) *
+			   remainder) /
+			  QUECTEL_LX6_COS_STEP);
+}
+
+/*
+ * Distance in millimeters between two nearby positions in nano degrees, using an
+ * equirectangular projection and alpha max plus beta min, within 5%.
+ */
+static uint64_t quectel_lx6_distance_mm(int64_t latitude_a, int64_t longitude_a,
+					int64_t latitude_b, int64_t longitude_b)
+{
+	int64_t dlongitude = longitude_b - longitude_a;
+	uint64_t dx;
+	uint64_t dy;
+
+	/* Shortest way across the antimeridian */
+	if (dlongitude > (180 * QUECTEL_LX6_NANO_DEGREES)) {
+		dlongitude -= 360 * QUECTEL_LX6_NANO_DEGREES;
+	} else if (dlongitude < -(180 * QUECTEL_LX6_NANO_DEGREES)) {
+		dlongitude += 360 * QUECTEL_LX6_NANO_DEGREES;
+	}
+
+	dy = quectel_lx6_abs(latitude_b - latitude_a) * QUECTEL_LX6_MM_PER_MILLIDEGREE / 1000000;
+	dx = quectel_lx6_abs(dlongitude) * QUECTEL_LX6_MM_PER_MILLIDEGREE / 1000000;
+	dx = (dx * quectel_lx6_cos_q15_of((latitude_a + latitude_b) / 2)) >> 15;
+
+	return ((MAX(dx, dy) * 123) + (MIN(dx, dy) * 51)) / 128;
+}
+
+static bool quectel_lx6_data_policy_met(const struct quectel_lx6_data_callback *cb,
+					const struct gnss_data *gnss_data, int64_t uptime_ms)
+{
+	const struct quectel_lx6_data_policy *policy = &cb->policy;
+	uint64_t distance;
+
+	if (!cb->last.delivered) {
+		return true;
+	}
+
+	if (policy->fix_changes && (gnss_data->info.fix_status != cb->last.fix_status)) {
+		return true;
+	}
+
+	if ((uptime_ms - cb->last.uptime_ms) < policy->min_interval_ms) {
+		return false;
+	}
+
+	if ((policy->min_distance_m == 0) && (policy->min_speed_change == 0)) {
+		return true;
+	}
+
+	if ((gnss_data->info.fix_status == GNSS_FIX_STATUS_NO_FIX) ||
+	    (cb->last.fix_status == GNSS_FIX_STATUS_NO_FIX)) {
+		return false;
+	}
+
+	if (policy->min_distance_m != 0) {
+		distance = quectel_lx6_distance_mm(cb->last.latitude, cb->last.longitude,
+						   gnss_data->nav_data.latitude,
+						   gnss_data->nav_data.longitude);
+		if (distance >= ((uint64_t)policy->min_distance_m * 1000)) {
+			return true;
+		}
+	}
+
+	return (policy->min_speed_change != 0) &&
+	       (quectel_lx6_abs((int64_t)gnss_data->nav_data.speed - cb->last.speed) >=
+		policy->min_speed_change);
+}
+
+static void quectel_lx6_data_deliver(const struct device *dev, const struct gnss_data *gnss_data)
+{
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_data_callback *cb;
+	int64_t uptime_ms = k_uptime_get();
+
+	k_mutex_lock(&data->data_callbacks_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&data->data_callbacks, cb, node) {
+		if (!quectel_lx6_data_policy_met(cb, gnss_data, uptime_ms)) {
+			continue;
+		}
+
+		cb->last.uptime_ms = uptime_ms;
+		cb->last.latitude = gnss_data->nav_data.latitude;
+		cb->last.longitude = gnss_data->nav_data.longitude;
+		cb->last.speed = gnss_data->nav_data.speed;
+		cb->last.fix_status = gnss_data->info.fix_status;
+		cb->last.delivered = true;
+		cb->handler(dev, cb, gnss_data);
+	}
+
+	k_mutex_unlock(&data->data_callbacks_lock);
+}
+#endif
+
+int quectel_lx6_add_data_callback(const struct device *dev, struct quectel_lx6_data_callback *cb)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	struct quectel_lx6_data *data = dev->data;
+	int ret = 0;
+
+	k_mutex_lock(&data->data_callbacks_lock, K_FOREVER);
+
+	if (sys_slist_find(&data->data_callbacks, &cb->node, NULL)) {
+		ret = -EALREADY;
 		goto unlock_return;
 	}
 
+	memset(&cb->last, 0, sizeof(cb->last));
+	sys_slist_append(&data->data_callbacks, &cb->node);
+
 unlock_return:
-	quectel_lx6_unlock(dev);
+	k_mutex_unlock(&data->data_callbacks_lock);
 	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-/* not supported in the specification protocol v2.2 */
-static int quectel_lx6_get_fix_rate(const struct device *dev, uint32_t *fix_interval_ms)
+int quectel_lx6_remove_data_callback(const struct device *dev,
+				     struct quectel_lx6_data_callback *cb)
 {
-	int ret = -ENOTSUP;
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	struct quectel_lx6_data *data = dev->data;
+	int ret = 0;
 
+	k_mutex_lock(&data->data_callbacks_lock, K_FOREVER);
+
+	if (!sys_slist_find_and_remove(&data->data_callbacks, &cb->node)) {
+		ret = -EINVAL;
+	}
+
+	k_mutex_unlock(&data->data_callbacks_lock);
 	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-static int quectel_lx6_set_navigation_mode(const struct device *dev, enum gnss_navigation_mode mode)
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE || CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+/*
+ * Reissue the NMEA output once its consumers changed. While the receiver is
+ * not active, the output is computed again when resumed.
+ */
+static void quectel_lx6_update_nmea_output(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
-	uint8_t navigation_mode = 0;
+	uint8_t sentences;
 	int ret;
 
-	switch (mode) {
-	case GNSS_NAVIGATION_MODE_ZERO_DYNAMICS:
-		navigation_mode = QUECTEL_LX6_PMTK_NAV_MODE_STATIONARY;
-		break;
-
-	case GNSS_NAVIGATION_MODE_LOW_DYNAMICS:
-		navigation_mode = QUECTEL_LX6_PMTK_NAV_MODE_FITNESS;
-		break;
-
-	case GNSS_NAVIGATION_MODE_BALANCED_DYNAMICS:
-		navigation_mode = QUECTEL_LX6_PMTK_NAV_MODE_NORMAL;
-		break;
-
-	case GNSS_NAVIGATION_MODE_HIGH_DYNAMICS:
-		navigation_mode = QUECTEL_LX6_PMTK_NAV_MODE_AVIATION;
-		break;
-	}
-
 	quectel_lx6_lock(dev);
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
-				     "PMTK886,%u", navigation_mode);
-	if (ret < 0) {
+	if (!data->active || !(data->profile.settings & QUECTEL_LX6_PROFILE_NMEA_OUTPUT)) {
 		goto unlock_return;
 	}
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
+	sentences = quectel_lx6_consumed_nmea_output(dev, data->profile.nmea_output);
+	if (sentences == data->nmea_output) {
 		goto unlock_return;
 	}
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_match_buf, sizeof(data->pmtk_match_buf),
-				     "PMTK001,886,%u", navigation_mode);
+	/* Command would be lost while the receiver sleeps */
+	ret = quectel_lx6_wake(dev);
 	if (ret < 0) {
+		LOG_WRN("Failed to update NMEA output");
 		goto unlock_return;
 	}
 
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		goto unlock_return;
+	quectel_lx6_batch_reset(data);
+
+	ret = quectel_lx6_batch_nmea_output(data, sentences, data->profile.nmea_intervals);
+	if (ret == 0) {
+		ret = quectel_lx6_batch_run(dev);
+	}
+
+	if (ret == 0) {
+		data->nmea_output = sentences;
+	} else {
+		LOG_WRN("Failed to update NMEA output");
 	}
 
-	ret = modem_chat_run_script(&data->chat, &data->pmtk_script);
+	/* Power mode is restored even if the update failed */
+	ret = quectel_lx6_restore_power_mode(dev);
 	if (ret < 0) {
-		goto unlock_return;
+		LOG_WRN("Failed to restore power mode");
 	}
 
 unlock_return:
 	quectel_lx6_unlock(dev);
-	return ret;
 }
+#endif
 
-/* not supported in the specification protocol v2.2 */
-static int quectel_lx6_get_navigation_mode(const struct device *dev,
-					   enum gnss_navigation_mode *mode)
-{
-	int ret = -ENOTSUP;
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+/* Deltas are forwarded in batches to bound stack usage */
+#define QUECTEL_LX6_SATELLITE_BATCH_SIZE 8
 
-	return ret;
-}
+BUILD_ASSERT((int)QUECTEL_LX6_SATELLITE_ADDED == (int)LX6_NMEA0183_MATCH_SAT_ADDED);
+BUILD_ASSERT((int)QUECTEL_LX6_SATELLITE_CHANGED == (int)LX6_NMEA0183_MATCH_SAT_CHANGED);
+BUILD_ASSERT((int)QUECTEL_LX6_SATELLITE_REMOVED == (int)LX6_NMEA0183_MATCH_SAT_REMOVED);
 
-static int quectel_lx6_set_enabled_systems(const struct device *dev, gnss_systems_t systems)
+static void quectel_lx6_satellite_deltas(const struct device *dev,
+					 const struct lx6_nmea0183_match_sat_delta *deltas,
+					 uint16_t size)
 {
 	struct quectel_lx6_data *data = dev->data;
-	gnss_systems_t supported_systems;
-	int ret;
+	struct quectel_lx6_satellite_delta batch[QUECTEL_LX6_SATELLITE_BATCH_SIZE];
+	struct quectel_lx6_satellite_callback *cb;
+	uint16_t count;
 
-	supported_systems =
-		(GNSS_SYSTEM_GPS | GNSS_SYSTEM_GLONASS | GNSS_SYSTEM_GALILEO | GNSS_SYSTEM_BEIDOU);
+	k_mutex_lock(&data->satellite_callbacks_lock, K_FOREVER);
 
-	if ((~supported_systems) & systems) {
-		return -EINVAL;
+	if (sys_slist_is_empty(&data->satellite_callbacks)) {
+		goto unlock_return;
 	}
 
-	quectel_lx6_lock(dev);
+	for (uint16_t i = 0; i < size; i += count) {
+		count = MIN(size - i, ARRAY_SIZE(batch));
 
-	ret = gnss_nmea0183_snprintk(
-		data->pmtk_request_buf, sizeof(data->pmtk_request_buf), "PMTK353,%u,%u,%u,0,%u",
-		(0 < (systems & GNSS_SYSTEM_GPS)), (0 < (systems & GNSS_SYSTEM_GLONASS)),
-		(0 < (systems & GNSS_SYSTEM_GALILEO)), (0 < (systems & GNSS_SYSTEM_BEIDOU)));
-	if (ret < 0) {
-		goto unlock_return;
-	}
+		for (uint16_t j = 0; j < count; j++) {
+			batch[j].satellite = deltas[i + j].satellite;
+			batch[j].change = (enum quectel_lx6_satellite_change)deltas[i + j].change;
+		}
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
-		goto unlock_return;
+		SYS_SLIST_FOR_EACH_CONTAINER(&data->satellite_callbacks, cb, node) {
+			cb->handler(dev, cb, batch, count);
+		}
 	}
 
-	ret = gnss_nmea0183_snprintk(
-		data->pmtk_match_buf, sizeof(data->pmtk_match_buf), "PMTK001,353,3,%u,%u,%u,0,%u",
-		(0 < (systems & GNSS_SYSTEM_GPS)), (0 < (systems & GNSS_SYSTEM_GLONASS)),
-		(0 < (systems & GNSS_SYSTEM_GALILEO)), (0 < (systems & GNSS_SYSTEM_BEIDOU)));
-	if (ret < 0) {
-		goto unlock_return;
-	}
+unlock_return:
+	k_mutex_unlock(&data->satellite_callbacks_lock);
+}
+#endif
 
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+int quectel_lx6_add_satellite_callback(const struct device *dev,
+				       struct quectel_lx6_satellite_callback *cb)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	struct quectel_lx6_data *data = dev->data;
+	int ret = 0;
 
-	ret = modem_chat_run_script(&data->chat, &data->pmtk_script);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+	k_mutex_lock(&data->satellite_callbacks_lock, K_FOREVER);
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
-				     "PMTK313,%u", (0 < (systems & GNSS_SYSTEM_SBAS)));
-	if (ret < 0) {
+	if (sys_slist_find(&data->satellite_callbacks, &cb->node, NULL)) {
+		ret = -EALREADY;
 		goto unlock_return;
 	}
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+	sys_slist_append(&data->satellite_callbacks, &cb->node);
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_match_buf, sizeof(data->pmtk_match_buf),
-				     "PMTK001,313,3");
-	if (ret < 0) {
-		goto unlock_return;
+unlock_return:
+	k_mutex_unlock(&data->satellite_callbacks_lock);
+
+	if (ret == 0) {
+		quectel_lx6_update_nmea_output(dev);
 	}
 
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		goto unlock_return;
+	return ret;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int quectel_lx6_remove_satellite_callback(const struct device *dev,
+					  struct quectel_lx6_satellite_callback *cb)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	struct quectel_lx6_data *data = dev->data;
+	int ret = 0;
+
+	k_mutex_lock(&data->satellite_callbacks_lock, K_FOREVER);
+
+	if (!sys_slist_find_and_remove(&data->satellite_callbacks, &cb->node)) {
+		ret = -EINVAL;
 	}
 
-	ret = modem_chat_run_script(&data->chat, &data->pmtk_script);
-	if (ret < 0) {
-		goto unlock_return;
+	k_mutex_unlock(&data->satellite_callbacks_lock);
+
+	if (ret == 0) {
+		quectel_lx6_update_nmea_output(dev);
 	}
 
-unlock_return:
-	quectel_lx6_unlock(dev);
 	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-static inline bool search_mode_enabled(const char *arg)
-{
-	return arg[0] == '1';
-}
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+BUILD_ASSERT(QUECTEL_LX6_SATELLITES_START == LX6_NMEA0183_MATCH_SAT_STREAM_START);
+BUILD_ASSERT(QUECTEL_LX6_SATELLITES_END == LX6_NMEA0183_MATCH_SAT_STREAM_END);
 
-static void quectel_lx6_get_search_mode_callback(struct modem_chat *chat, char **argv,
-						 uint16_t argc, void *user_data)
+static void quectel_lx6_satellite_stream(const struct device *dev,
+					 const struct gnss_satellite *satellites, uint16_t size,
+					 uint8_t flags)
 {
-	struct quectel_lx6_data *data = user_data;
+	struct quectel_lx6_data *data = dev->data;
+	struct quectel_lx6_satellite_stream_callback *cb;
 
-	if (argc != 8) {
-		return;
+	k_mutex_lock(&data->satellite_stream_callbacks_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&data->satellite_stream_callbacks, cb, node) {
+		cb->handler(dev, cb, satellites, size, flags);
 	}
 
-	data->enabled_systems_response = search_mode_enabled(argv[1]) ? GNSS_SYSTEM_GPS : 0;
-	data->enabled_systems_response |= search_mode_enabled(argv[2]) ? GNSS_SYSTEM_GLONASS : 0;
-	data->enabled_systems_response |= search_mode_enabled(argv[3]) ? GNSS_SYSTEM_GALILEO : 0;
-	data->enabled_systems_response |= search_mode_enabled(argv[4]) ? GNSS_SYSTEM_BEIDOU : 0;
-	data->enabled_systems_response |= search_mode_enabled(argv[5]) ? GNSS_SYSTEM_QZSS : 0;
+	k_mutex_unlock(&data->satellite_stream_callbacks_lock);
 }
+#endif
 
-static int quectel_lx6_get_enabled_systems(const struct device *dev, gnss_systems_t *systems)
+int quectel_lx6_add_satellite_stream_callback(const struct device *dev,
+					      struct quectel_lx6_satellite_stream_callback *cb)
 {
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
 	struct quectel_lx6_data *data = dev->data;
-	int ret;
+	int ret = 0;
 
-	quectel_lx6_lock(dev);
+	k_mutex_lock(&data->satellite_stream_callbacks_lock, K_FOREVER);
 
-	ret = gnss_nmea0183_snprintk(data->pmtk_request_buf, sizeof(data->pmtk_request_buf),
-				     "PMTK355");
-	if (ret < 0) {
+	if (sys_slist_find(&data->satellite_stream_callbacks, &cb->node, NULL)) {
+		ret = -EALREADY;
 		goto unlock_return;
 	}
 
-	ret = modem_chat_script_chat_set_request(&data->pmtk_script_chat, data->pmtk_request_buf);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+	sys_slist_append(&data->satellite_stream_callbacks, &cb->node);
 
-	strncpy(data->pmtk_match_buf, "$PMTK001,355,3", sizeof(data->pmtk_match_buf));
-	ret = modem_chat_match_set_match(&data->pmtk_match, data->pmtk_match_buf);
-	if (ret < 0) {
-		goto unlock_return;
-	}
+unlock_return:
+	k_mutex_unlock(&data->satellite_stream_callbacks_lock);
 
-	modem_chat_match_set_callback(&data->pmtk_match, quectel_lx6_get_search_mode_callback);
-	ret = modem_chat_run_script(&data->chat, &data->pmtk_script);
-	modem_chat_match_set_callback(&data->pmtk_match, NULL);
-	if (ret < 0) {
-		goto unlock_return;
+	if (ret == 0) {
+		quectel_lx6_update_nmea_output(dev);
 	}
 
-	/* get SBAS system: not supported in protocol specification v2.2 */
-	*systems = data->enabled_systems_response;
-
-unlock_return:
-	quectel_lx6_unlock(dev);
 	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
-static int quectel_lx6_get_supported_systems(const struct device *dev, gnss_systems_t *systems)
+int quectel_lx6_remove_satellite_stream_callback(const struct device *dev,
+						 struct quectel_lx6_satellite_stream_callback *cb)
 {
-	*systems = (GNSS_SYSTEM_GPS | GNSS_SYSTEM_GLONASS | GNSS_SYSTEM_GALILEO |
-		    GNSS_SYSTEM_BEIDOU | GNSS_SYSTEM_QZSS | GNSS_SYSTEM_SBAS);
-	return 0;
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	struct quectel_lx6_data *data = dev->data;
+	int ret = 0;
+
+	k_mutex_lock(&data->satellite_stream_callbacks_lock, K_FOREVER);
+
+	if (!sys_slist_find_and_remove(&data->satellite_stream_callbacks, &cb->node)) {
+		ret = -EINVAL;
+	}
+
+	k_mutex_unlock(&data->satellite_stream_callbacks_lock);
+
+	if (ret == 0) {
+		quectel_lx6_update_nmea_output(dev);
+	}
+
+	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
 static const struct gnss_driver_api gnss_api = {
@@ -610,19 +2961,60 @@ static const struct gnss_driver_api gnss_api = {
 	.get_supported_systems = quectel_lx6_get_supported_systems,
 };
 
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+static int quectel_lx6_init_history(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	const struct gnss_history_config history_config = {
+		.buf = data->history_buf,
+		.buf_size = ARRAY_SIZE(data->history_buf),
+	};
+
+	return gnss_history_init(&data->history, &history_config);
+}
+#endif
+
 static int quectel_lx6_init_nmea0183_match(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
 
-	const struct gnss_nmea0183_match_config config = {
+	const struct lx6_nmea0183_match_config config = {
 		.gnss = dev,
-#if CONFIG_GNSS_SATELLITES
+		.epoch_required = QUECTEL_LX6_EPOCH_REQUIRED,
+		.epoch_policy = QUECTEL_LX6_EPOCH_POLICY,
+		.epoch_timeout = K_MSEC(CONFIG_GNSS_QUECTEL_LX6_EPOCH_TIMEOUT_MS),
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+		.workq = &data->workq,
+#endif
+#if CONFIG_GNSS_SATELLITES && !CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
 		.satellites = data->satellites,
 		.satellites_size = ARRAY_SIZE(data->satellites),
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+		.sat_stream_callback = quectel_lx6_satellite_stream,
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+		.accuracy_gate = CONFIG_GNSS_QUECTEL_LX6_ACCURACY_GATE_MM,
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+		.history = &data->history,
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+		.data_callback = quectel_lx6_data_deliver,
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+		.fix_callback = quectel_lx6_ttff_fix,
+#endif
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+		.sat_delta_callback = quectel_lx6_satellite_deltas,
+		.sat_snr_hysteresis = CONFIG_GNSS_QUECTEL_LX6_SAT_SNR_HYSTERESIS,
+		.sat_elevation_hysteresis = CONFIG_GNSS_QUECTEL_LX6_SAT_ELEVATION_HYSTERESIS,
+		.sat_max_age = CONFIG_GNSS_QUECTEL_LX6_SAT_MAX_AGE,
 #endif
 	};
 
-	return gnss_nmea0183_match_init(&data->match_data, &config);
+	return lx6_nmea0183_match_init(&data->match_data, &config);
 }
 
 static void quectel_lx6_init_pipe(const struct device *dev)
@@ -641,6 +3033,25 @@ static void quectel_lx6_init_pipe(const struct device *dev)
 	data->uart_pipe = modem_backend_uart_init(&data->uart_backend, &uart_backend_config);
 }
 
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+static int quectel_lx6_init_pmtk_queue(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	const struct gnss_pmtk_queue_config pmtk_queue_config = {
+		.gnss = dev,
+		.pipe = data->uart_pipe,
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+		.workq = &data->workq,
+#endif
+		.requests = data->pmtk_queue_requests,
+		.requests_size = ARRAY_SIZE(data->pmtk_queue_requests),
+	};
+
+	return gnss_pmtk_queue_init(&data->pmtk_queue, &pmtk_queue_config);
+}
+#endif
+
 static int quectel_lx6_init_chat(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
@@ -662,6 +3073,42 @@ static int quectel_lx6_init_chat(const struct device *dev)
 	return modem_chat_init(&data->chat, &chat_config);
 }
 
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+static int quectel_lx6_init_framer(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	const struct lx6_nmea0183_framer_config framer_config = {
+		.buf = data->framer_buf,
+		.buf_size = ARRAY_SIZE(data->framer_buf),
+		.argv = data->framer_argv,
+		.argv_size = ARRAY_SIZE(data->framer_argv),
+		.callback = quectel_lx6_framer_callback,
+		.user_data = data,
+	};
+
+	k_work_init(&data->framer_work, quectel_lx6_framer_work_handler);
+
+	return lx6_nmea0183_framer_init(&data->framer, &framer_config);
+}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+static void quectel_lx6_init_workq(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	const struct k_work_queue_config workq_config = {
+		.name = dev->name,
+	};
+
+	k_work_queue_init(&data->workq);
+	k_work_queue_start(&data->workq, data->workq_stack,
+			   K_KERNEL_STACK_SIZEOF(data->workq_stack),
+			   CONFIG_GNSS_QUECTEL_LX6_WORKQ_PRIORITY, &workq_config);
+}
+#endif
+
 static void quectel_lx6_init_pmtk_script(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
@@ -679,12 +3126,117 @@ static void quectel_lx6_init_pmtk_script(const struct device *dev)
 	modem_chat_script_set_timeout(&data->pmtk_script, 10);
 }
 
+static void quectel_lx6_init_batch_script(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	for (uint8_t i = 0; i < QUECTEL_LX6_BATCH_SIZE; i++) {
+		modem_chat_match_init(&data->batch_matches[i]);
+		modem_chat_match_set_separators(&data->batch_matches[i], ",*");
+
+		modem_chat_script_chat_init(&data->batch_script_chats[i]);
+		modem_chat_script_chat_set_response_matches(&data->batch_script_chats[i],
+							    &data->batch_matches[i], 1);
+	}
+
+	modem_chat_script_init(&data->batch_script);
+	modem_chat_script_set_name(&data->batch_script, "batch");
+	modem_chat_script_set_abort_matches(&data->batch_script, NULL, 0);
+	modem_chat_script_set_timeout(&data->batch_script, QUECTEL_LX6_SCRIPT_TIMEOUT_S);
+}
+
+static void quectel_lx6_init_restart_script(const struct device *dev)
+{
+	struct quectel_lx6_data *data = dev->data;
+
+	modem_chat_script_chat_init(&data->restart_script_chat);
+	modem_chat_script_chat_set_response_matches(&data->restart_script_chat, NULL, 0);
+	modem_chat_script_chat_set_timeout(&data->restart_script_chat, 0);
+
+	modem_chat_script_init(&data->restart_script);
+	modem_chat_script_set_name(&data->restart_script, "restart");
+	modem_chat_script_set_script_chats(&data->restart_script, &data->restart_script_chat, 1);
+	modem_chat_script_set_abort_matches(&data->restart_script, NULL, 0);
+	modem_chat_script_set_timeout(&data->restart_script, QUECTEL_LX6_SCRIPT_TIMEOUT_S);
+}
+
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+static void quectel_lx6_init_speed_script(const struct device *dev)
+{
+	const struct quectel_lx6_config *config = dev->config;
+	struct quectel_lx6_data *data = dev->data;
+
+	data->speed = config->default_speed;
+
+	/* PMTK251 is not acknowledged, the script only waits for it to be written */
+	modem_chat_script_chat_init(&data->speed_script_chat);
+	modem_chat_script_chat_set_response_matches(&data->speed_script_chat, NULL, 0);
+	modem_chat_script_chat_set_timeout(&data->speed_script_chat,
+					   QUECTEL_LX6_SPEED_SWITCH_MS);
+
+	modem_chat_script_init(&data->speed_script);
+	modem_chat_script_set_name(&data->speed_script, "speed");
+	modem_chat_script_set_script_chats(&data->speed_script, &data->speed_script_chat, 1);
+	modem_chat_script_set_abort_matches(&data->speed_script, NULL, 0);
+	modem_chat_script_set_timeout(&data->speed_script, QUECTEL_LX6_SCRIPT_TIMEOUT_S);
+}
+#endif
+
+static void quectel_lx6_init_profile(const struct device *dev)
+{
+	const struct quectel_lx6_config *config = dev->config;
+	struct quectel_lx6_data *data = dev->data;
+
+	/* Other settings are left to the receiver defaults until applied */
+	data->profile.settings = QUECTEL_LX6_PROFILE_NMEA_OUTPUT | QUECTEL_LX6_PROFILE_PPS;
+	data->profile.nmea_output = QUECTEL_LX6_NMEA_OUTPUT;
+	data->profile.pps_mode = config->pps_mode;
+	data->profile.pps_pulse_width = config->pps_pulse_width;
+
+	if (config->power.mode != QUECTEL_LX6_POWER_MODE_FULL) {
+		data->profile.settings |= QUECTEL_LX6_PROFILE_POWER_MODE;
+		data->profile.power = config->power;
+	}
+}
+
 static int quectel_lx6_init(const struct device *dev)
 {
 	struct quectel_lx6_data *data = dev->data;
 	int ret;
 
 	k_sem_init(&data->lock, 1, 1);
+	k_sem_init(&data->pm_ready_sem, 0, 1);
+	k_sem_init(&data->startup_sem, 0, 1);
+
+#if CONFIG_GNSS_QUECTEL_LX6_TTFF
+	data->ttff_hdop = CONFIG_GNSS_QUECTEL_LX6_TTFF_HDOP;
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+	sys_slist_init(&data->data_callbacks);
+	k_mutex_init(&data->data_callbacks_lock);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+	sys_slist_init(&data->satellite_callbacks);
+	k_mutex_init(&data->satellite_callbacks_lock);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+	sys_slist_init(&data->satellite_stream_callbacks);
+	k_mutex_init(&data->satellite_stream_callbacks_lock);
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_HISTORY
+	ret = quectel_lx6_init_history(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
+#if CONFIG_GNSS_QUECTEL_LX6_WORKQ
+	quectel_lx6_init_workq(dev);
+#endif
 
 	ret = quectel_lx6_init_nmea0183_match(dev);
 	if (ret < 0) {
@@ -693,21 +3245,45 @@ static int quectel_lx6_init(const struct device *dev)
 
 	quectel_lx6_init_pipe(dev);
 
+#if CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE
+	ret = quectel_lx6_init_pmtk_queue(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
 	ret = quectel_lx6_init_chat(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER
+	ret = quectel_lx6_init_framer(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
 	quectel_lx6_init_pmtk_script(dev);
+	quectel_lx6_init_restart_script(dev);
+	quectel_lx6_init_batch_script(dev);
+#if CONFIG_UART_USE_RUNTIME_CONFIGURE
+	quectel_lx6_init_speed_script(dev);
+#endif
+	quectel_lx6_init_profile(dev);
 
 	quectel_lx6_pm_changed(dev);
 
 	if (pm_device_is_powered(dev)) {
+		/* Receiver powered along with the system is not waited for */
+		quectel_lx6_pm_ready(data);
+
 		ret = quectel_lx6_resume(dev);
 		if (ret < 0) {
 			return ret;
 		}
 		quectel_lx6_pm_changed(dev);
+		quectel_lx6_pm_ready(data);
 	} else {
 		pm_device_init_off(dev);
 	}
@@ -717,11 +3293,33 @@ static int quectel_lx6_init(const struct device *dev)
 
 #define LX6_INST_NAME(inst, name) _CONCAT(_CONCAT(_CONCAT(name, _), DT_DRV_COMPAT), inst)
 
+/* Power modes of the devicetree are ordered like enum quectel_lx6_power_mode */
+#define LX6_INST_POWER_PERIODIC(inst)                                                              \
+	((DT_INST_ENUM_IDX(inst, power_mode) == QUECTEL_LX6_POWER_MODE_PERIODIC_STANDBY) ||        \
+	 (DT_INST_ENUM_IDX(inst, power_mode) == QUECTEL_LX6_POWER_MODE_PERIODIC_BACKUP))
+
 #define LX6_DEVICE(inst)                                                                           \
+	BUILD_ASSERT(!DT_INST_NODE_HAS_PROP(inst, target_speed) ||                                 \
+			     IS_ENABLED(CONFIG_UART_USE_RUNTIME_CONFIGURE),                        \
+		     "target-speed requires CONFIG_UART_USE_RUNTIME_CONFIGURE");                   \
+	BUILD_ASSERT(!LX6_INST_POWER_PERIODIC(inst) ||                                             \
+			     (DT_INST_NODE_HAS_PROP(inst, power_run_time_ms) &&                    \
+			      DT_INST_NODE_HAS_PROP(inst, power_sleep_time_ms)),                   \
+		     "periodic power modes require power-run-time-ms and power-sleep-time-ms");    \
+                                                                                                   \
 	static const struct quectel_lx6_config LX6_INST_NAME(inst, config) = {                     \
 		.uart = DEVICE_DT_GET(DT_INST_BUS(inst)),                                          \
 		.pps_mode = DT_INST_STRING_UPPER_TOKEN(inst, pps_mode),                            \
 		.pps_pulse_width = DT_INST_PROP(inst, pps_pulse_width),                            \
+		.default_speed = DT_PROP(DT_INST_BUS(inst), current_speed),                        \
+		.target_speed = DT_INST_PROP_OR(inst, target_speed, 0),                            \
+		.power = {                                                                         \
+			.mode = DT_INST_ENUM_IDX(inst, power_mode),                                \
+			.run_ms = DT_INST_PROP_OR(inst, power_run_time_ms, 0),                     \
+			.sleep_ms = DT_INST_PROP_OR(inst, power_sleep_time_ms, 0),                 \
+			.second_run_ms = DT_INST_PROP_OR(inst, power_second_run_time_ms, 0),       \
+			.second_sleep_ms = DT_INST_PROP_OR(inst, power_second_sleep_time_ms, 0),   \
+		},                                                                                 \
 	};                                                                                         \
                                                                                                    \
 	static struct quectel_lx6_data LX6_INST_NAME(inst, data) = {                               \
@@ -0,0 +1,949 @@
+/*
+ * Copyright (c) 2024, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Quectel LX6 GNSS extended API
+ *
+ * Functionality specific to Quectel LX6 modules which is not covered by the
+ * generic GNSS API.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_GNSS_QUECTEL_LX6_H_
+#define ZEPHYR_INCLUDE_DRIVERS_GNSS_QUECTEL_LX6_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gnss.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name NMEA0183 sentences
+ * @{
+ */
+#define QUECTEL_LX6_NMEA_GGA BIT(0)
+#define QUECTEL_LX6_NMEA_RMC BIT(1)
+#define QUECTEL_LX6_NMEA_GLL BIT(2)
+#define QUECTEL_LX6_NMEA_VTG BIT(3)
+#define QUECTEL_LX6_NMEA_ZDA BIT(4)
+#define QUECTEL_LX6_NMEA_GST BIT(5)
+/** Output only, can't be required in epochs */
+#define QUECTEL_LX6_NMEA_GSA BIT(6)
+/** Output only, can't be required in epochs */
+#define QUECTEL_LX6_NMEA_GSV BIT(7)
+/** @} */
+
+/** Number of NMEA0183 sentences */
+#define QUECTEL_LX6_NMEA_SENTENCES 8
+
+/** Longest output interval of a sentence, in number of fixes */
+#define QUECTEL_LX6_NMEA_INTERVAL_MAX 5
+
+/**
+ * @name Settings of a receiver profile
+ * @{
+ */
+#define QUECTEL_LX6_PROFILE_FIX_RATE        BIT(0)
+#define QUECTEL_LX6_PROFILE_NAVIGATION_MODE BIT(1)
+#define QUECTEL_LX6_PROFILE_SYSTEMS         BIT(2)
+#define QUECTEL_LX6_PROFILE_PPS             BIT(3)
+#define QUECTEL_LX6_PROFILE_NMEA_OUTPUT     BIT(4)
+#define QUECTEL_LX6_PROFILE_POWER_MODE      BIT(5)
+#define QUECTEL_LX6_PROFILE_ALL             (BIT(6) - 1)
+/** @} */
+
+/** Power modes, in which the receiver cycles on its own without commands */
+enum quectel_lx6_power_mode {
+	/** Full power, tracking continuously */
+	QUECTEL_LX6_POWER_MODE_FULL = 0,
+	/** Alternates running and sleeping in standby mode for fixed times */
+	QUECTEL_LX6_POWER_MODE_PERIODIC_STANDBY,
+	/** Alternates running and sleeping in backup mode for fixed times */
+	QUECTEL_LX6_POWER_MODE_PERIODIC_BACKUP,
+	/** Adapts running and sleeping in standby mode to the environment */
+	QUECTEL_LX6_POWER_MODE_ALWAYSLOCATE_STANDBY,
+	/** Adapts running and sleeping in backup mode to the environment */
+	QUECTEL_LX6_POWER_MODE_ALWAYSLOCATE_BACKUP,
+};
+
+/** Shortest run or sleep time of periodic power modes in milliseconds */
+#define QUECTEL_LX6_POWER_TIME_MIN_MS 1000U
+/** Longest run or sleep time of periodic power modes in milliseconds */
+#define QUECTEL_LX6_POWER_TIME_MAX_MS 518400000U
+
+/** Power mode settings */
+struct quectel_lx6_power {
+	/** Power mode */
+	enum quectel_lx6_power_mode mode;
+	/** Run time of periodic modes in milliseconds */
+	uint32_t run_ms;
+	/** Sleep time of periodic modes in milliseconds */
+	uint32_t sleep_ms;
+	/** Run time of periodic modes once no fix was obtained within run_ms, 0 to disable */
+	uint32_t second_run_ms;
+	/** Sleep time of periodic modes once no fix was obtained within run_ms, 0 to disable */
+	uint32_t second_sleep_ms;
+};
+
+/** Receiver settings, only the ones flagged in settings are applied */
+struct quectel_lx6_profile {
+	/** Mask of QUECTEL_LX6_PROFILE_* settings */
+	uint8_t settings;
+	/** Fix interval in milliseconds, from 200 to 1000 */
+	uint32_t fix_interval_ms;
+	/** Navigation mode */
+	enum gnss_navigation_mode navigation_mode;
+	/** Enabled systems, SBAS included, QZSS can't be configured */
+	gnss_systems_t systems;
+	/** PPS mode */
+	enum gnss_pps_mode pps_mode;
+	/** PPS pulse width in milliseconds */
+	uint16_t pps_pulse_width;
+	/**
+	 * Mask of QUECTEL_LX6_NMEA_* sentences output by the receiver. GSV is left out
+	 * while no satellites callback is registered.
+	 */
+	uint8_t nmea_output;
+	/**
+	 * Output interval in number of fixes of each sentence of nmea_output, indexed
+	 * by the bit position of the sentence, up to QUECTEL_LX6_NMEA_INTERVAL_MAX.
+	 * 0 outputs the sentence every fix, like 1.
+	 */
+	uint8_t nmea_intervals[QUECTEL_LX6_NMEA_SENTENCES];
+	/** Power mode */
+	struct quectel_lx6_power power;
+};
+
+/** Number of buckets of latency histograms */
+#define QUECTEL_LX6_LATENCY_BUCKETS 24
+
+/** Latency distribution */
+struct quectel_lx6_latency {
+	/** Number of samples */
+	uint32_t count;
+	/** Minimum latency in microseconds */
+	uint32_t min_us;
+	/** Maximum latency in microseconds */
+	uint32_t max_us;
+	/** Sum of latencies in microseconds */
+	uint64_t total_us;
+	/** Bucket n counts latencies within [2^n, 2^(n+1)) microseconds */
+	uint32_t histogram[QUECTEL_LX6_LATENCY_BUCKETS];
+};
+
+/** Epoch statistics */
+struct quectel_lx6_epoch_stats {
+	/** Number of epochs containing all required sentences */
+	uint32_t complete;
+	/** Number of incomplete epochs which have been published */
+	uint32_t partial;
+	/** Number of incomplete epochs which have been dropped */
+	uint32_t dropped;
+	/** Number of epochs dropped by the accuracy gate */
+	uint32_t gated;
+	/** Latency from first byte of epoch to reception of its last required sentence */
+	struct quectel_lx6_latency assembly;
+	/** Latency from first byte of epoch to publication */
+	struct quectel_lx6_latency publish;
+};
+
+/** Resume statistics */
+struct quectel_lx6_resume_stats {
+	/** Number of successful resumes */
+	uint32_t count;
+	/** Time the last resume took until the receiver was configured, in milliseconds */
+	uint32_t last_ms;
+	/** Longest resume time in milliseconds */
+	uint32_t max_ms;
+	/** Sum of resume times in milliseconds */
+	uint64_t total_ms;
+	/** Time last blocked waiting for the receiver to be ready, in milliseconds */
+	uint32_t last_ready_wait_ms;
+	/** Number of waits which reached the upper bound without any output from the receiver */
+	uint32_t ready_timeouts;
+};
+
+/** Restart types */
+enum quectel_lx6_restart {
+	/** Restart using all available data, PMTK101 */
+	QUECTEL_LX6_RESTART_HOT = 0,
+	/** Restart discarding ephemeris, PMTK102 */
+	QUECTEL_LX6_RESTART_WARM,
+	/** Restart discarding time, position, almanac and ephemeris, PMTK103 */
+	QUECTEL_LX6_RESTART_COLD,
+	/** Cold restart also resetting the receiver to its factory settings, PMTK104 */
+	QUECTEL_LX6_RESTART_FULL_COLD,
+	/** Resume of the device, only used to index time to first fix statistics */
+	QUECTEL_LX6_RESTART_RESUME,
+};
+
+/** Number of restart types */
+#define QUECTEL_LX6_RESTARTS 5
+
+/** Time to first fix distribution */
+struct quectel_lx6_ttff {
+	/** Number of samples */
+	uint32_t count;
+	/** Shortest time to first fix in milliseconds */
+	uint32_t min_ms;
+	/** Longest time to first fix in milliseconds */
+	uint32_t max_ms;
+	/** Sum of times to first fix in milliseconds */
+	uint64_t total_ms;
+};
+
+/** Time to first fix statistics of a restart type */
+struct quectel_lx6_ttff_stats {
+	/** Number of restarts */
+	uint32_t restarts;
+	/** Time to the first fix */
+	struct quectel_lx6_ttff fix;
+	/** Time to the first fix whose HDOP is within the threshold */
+	struct quectel_lx6_ttff hdop_fix;
+};
+
+/** Utilization of the UART link to the receiver */
+struct quectel_lx6_link_budget {
+	/** Speed of the link in baud */
+	uint32_t speed;
+	/** Worst case number of bytes per second output with the applied settings */
+	uint32_t estimated_bytes_per_s;
+	/** Worst case utilization in percent */
+	uint32_t estimated_utilization;
+	/** Number of bytes per second received over the last second */
+	uint32_t measured_bytes_per_s;
+	/** Measured utilization in percent */
+	uint32_t measured_utilization;
+};
+
+/** Dilution of precision, in thousandths */
+struct quectel_lx6_dop {
+	/** Position dilution of precision */
+	uint32_t pdop;
+	/** Horizontal dilution of precision */
+	uint32_t hdop;
+	/** Vertical dilution of precision */
+	uint32_t vdop;
+};
+
+/** Fix stored in history */
+struct quectel_lx6_fix {
+	/** Milliseconds since 2000-01-01T00:00:00 UTC, or since midnight if date is unknown */
+	uint64_t timestamp_ms;
+	/** Latitude in nano degrees */
+	int64_t latitude;
+	/** Longitude in nano degrees */
+	int64_t longitude;
+	/** Altitude above MSL in millimeters */
+	int32_t altitude;
+	/** Speed in millimeters per second */
+	uint32_t speed;
+	/** Bearing in milli degrees */
+	uint32_t bearing;
+};
+
+/**
+ * @brief Callback invoked for every fix visited in history
+ *
+ * @retval true to continue visiting fixes
+ * @retval false to stop
+ */
+typedef bool (*quectel_lx6_history_visit_t)(const struct quectel_lx6_fix *fix, void *user_data);
+
+/** Change of a satellite since it was last notified */
+enum quectel_lx6_satellite_change {
+	/** Satellite is reported for the first time */
+	QUECTEL_LX6_SATELLITE_ADDED = 0,
+	/** Tracking state, SNR or elevation of satellite changed beyond hysteresis */
+	QUECTEL_LX6_SATELLITE_CHANGED,
+	/** Satellite has not been reported for too long */
+	QUECTEL_LX6_SATELLITE_REMOVED,
+};
+
+/** Satellite which changed since it was last notified */
+struct quectel_lx6_satellite_delta {
+	/** Satellite as reported, or as last notified if removed */
+	struct gnss_satellite satellite;
+	/** Change of satellite */
+	enum quectel_lx6_satellite_change change;
+};
+
+struct quectel_lx6_satellite_callback;
+
+/**
+ * @brief Handler invoked with the satellites which changed within a sky view
+ *
+ * @param dev Device instance
+ * @param cb Registered callback, may be used to retrieve user data with CONTAINER_OF
+ * @param deltas Changed satellites
+ * @param size Number of changed satellites
+ */
+typedef void (*quectel_lx6_satellite_handler_t)(const struct device *dev,
+						struct quectel_lx6_satellite_callback *cb,
+						const struct quectel_lx6_satellite_delta *deltas,
+						uint16_t size);
+
+/** Satellite delta callback */
+struct quectel_lx6_satellite_callback {
+	/** Used by driver, must not be modified */
+	sys_snode_t node;
+	/** Handler invoked with changed satellites */
+	quectel_lx6_satellite_handler_t handler;
+};
+
+/**
+ * @brief Delivery policy of a data callback
+ *
+ * @details An epoch is delivered if it is the first one, if its fix status
+ * changed and fix changes are delivered, or if the minimum interval elapsed and
+ * either no motion criterion is set or one of them is met. Motion criteria
+ * compare against the last delivered epoch and are never met without fix.
+ * Criteria set to 0 are disabled.
+ */
+struct quectel_lx6_data_policy {
+	/** Minimum time between deliveries in milliseconds */
+	uint32_t min_interval_ms;
+	/** Minimum distance from the last delivered position in meters */
+	uint32_t min_distance_m;
+	/** Minimum speed change from the last delivered speed in millimeters per second */
+	uint32_t min_speed_change;
+	/** Deliver epochs whose fix status changed regardless of other criteria */
+	bool fix_changes;
+};
+
+struct quectel_lx6_data_callback;
+
+/**
+ * @brief Handler invoked with the epochs which meet the policy of the callback
+ *
+ * @param dev Device instance
+ * @param cb Registered callback, may be used to retrieve user data with CONTAINER_OF
+ * @param data Published data, only valid for the duration of the call
+ */
+typedef void (*quectel_lx6_data_handler_t)(const struct device *dev,
+					   struct quectel_lx6_data_callback *cb,
+					   const struct gnss_data *data);
+
+/** Data callback with delivery policy */
+struct quectel_lx6_data_callback {
+	/** Used by driver, must not be modified */
+	sys_snode_t node;
+	/** Handler invoked with delivered epochs */
+	quectel_lx6_data_handler_t handler;
+	/** Delivery policy */
+	struct quectel_lx6_data_policy policy;
+	/** Used by driver, last delivered epoch */
+	struct {
+		int64_t uptime_ms;
+		int64_t latitude;
+		int64_t longitude;
+		uint32_t speed;
+		enum gnss_fix_status fix_status;
+		bool delivered;
+	} last;
+};
+
+/**
+ * @name Satellite stream markers
+ * @{
+ */
+/** Chunk continues the sky view */
+#define QUECTEL_LX6_SATELLITES_CONTINUE 0
+/** Chunk starts a sky view */
+#define QUECTEL_LX6_SATELLITES_START    BIT(0)
+/** Chunk ends the sky view */
+#define QUECTEL_LX6_SATELLITES_END      BIT(1)
+/** @} */
+
+struct quectel_lx6_satellite_stream_callback;
+
+/**
+ * @brief Handler invoked with every chunk of streamed satellites
+ *
+ * @param dev Device instance
+ * @param cb Registered callback, may be used to retrieve user data with CONTAINER_OF
+ * @param satellites Satellites of chunk, only valid for the duration of the call
+ * @param size Number of satellites in chunk, at most 4, may be 0 for the last chunk
+ * @param flags QUECTEL_LX6_SATELLITES_* markers
+ */
+typedef void (*quectel_lx6_satellite_stream_handler_t)(
+	const struct device *dev, struct quectel_lx6_satellite_stream_callback *cb,
+	const struct gnss_satellite *satellites, uint16_t size, uint8_t flags);
+
+/** Satellite stream callback */
+struct quectel_lx6_satellite_stream_callback {
+	/** Used by driver, must not be modified */
+	sys_snode_t node;
+	/** Handler invoked with every chunk of satellites */
+	quectel_lx6_satellite_stream_handler_t handler;
+};
+
+/**
+ * @brief Get a snapshot of the latest published navigation data
+ *
+ * @details May be called from any thread at any rate. The snapshot is consistent
+ * and copied without blocking the driver, nor registering a callback.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_LATEST_FIX
+ *
+ * @param dev Device instance
+ * @param latest Destination for navigation data
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no navigation data has been published yet
+ * @retval -ENOTSUP if snapshots are disabled
+ */
+int quectel_lx6_get_latest_fix(const struct device *dev, struct gnss_data *latest);
+
+/**
+ * @brief Get dilution of precision of the latest fix
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+ *
+ * @param dev Device instance
+ * @param dop Destination for dilution of precision
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no dilution of precision has been received yet
+ * @retval -ENOTSUP if GSA sentences are not handled
+ */
+int quectel_lx6_get_dop(const struct device *dev, struct quectel_lx6_dop *dop);
+
+/**
+ * @brief Check if a satellite is used for the latest fix
+ *
+ * @details Intended to be called from a GNSS satellites callback, with one of
+ * the published satellites.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA
+ *
+ * @param dev Device instance
+ * @param satellite Satellite to look up
+ *
+ * @retval true if satellite is used for fix
+ * @retval false otherwise
+ */
+bool quectel_lx6_satellite_is_used(const struct device *dev,
+				   const struct gnss_satellite *satellite);
+
+/** Standard deviations of position errors, in millimeters */
+struct quectel_lx6_accuracy {
+	/** Standard deviation of latitude error */
+	uint32_t latitude_stddev;
+	/** Standard deviation of longitude error */
+	uint32_t longitude_stddev;
+	/** Standard deviation of altitude error */
+	uint32_t altitude_stddev;
+};
+
+/**
+ * @brief Get standard deviations of position errors of the latest fix
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+ *
+ * @param dev Device instance
+ * @param accuracy Destination for standard deviations of position errors
+ *
+ * @retval 0 if successful
+ * @retval -ENODATA if no error statistics have been received yet
+ * @retval -ENOTSUP if GST sentences are not handled
+ */
+int quectel_lx6_get_accuracy(const struct device *dev, struct quectel_lx6_accuracy *accuracy);
+
+/**
+ * @brief Set accuracy gate
+ *
+ * @details Fixes whose horizontal standard deviation exceeds the gate are not
+ * published. Loss of fix is always published.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_NMEA_GST
+ *
+ * @param dev Device instance
+ * @param horizontal_stddev_mm Horizontal standard deviation in millimeters, 0 to disable
+ *
+ * @retval 0 if successful
+ * @retval -ENOTSUP if GST sentences are not handled
+ */
+int quectel_lx6_set_accuracy_gate(const struct device *dev, uint32_t horizontal_stddev_mm);
+
+/**
+ * @brief Set sentences which must be received for an epoch to be complete
+ *
+ * @details Complete epochs are published as soon as their last required sentence
+ * is received. Defaults to all enabled navigation sentences. Required sentences
+ * must be part of the applied NMEA output, and at least one of them must be
+ * output every fix.
+ *
+ * @param dev Device instance
+ * @param sentences Mask of QUECTEL_LX6_NMEA_* sentences
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if mask is empty, contains unknown sentences or sentences which
+ * are not output, or only sentences which are not output every fix
+ */
+int quectel_lx6_set_epoch_required(const struct device *dev, uint8_t sentences);
+
+/**
+ * @brief Set the output interval of NMEA0183 sentences
+ *
+ * @details Sentences output every n fixes are not awaited to complete the epochs
+ * they are missing from, the values they carry are kept from the last epoch
+ * they were received in. At least one required sentence must be output every
+ * fix. The interval is applied to the receiver like a profile setting.
+ *
+ * @param dev Device instance
+ * @param sentences Mask of QUECTEL_LX6_NMEA_* sentences
+ * @param fixes Output interval in number of fixes, 0 to disable output
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if sentences are not handled, if interval is greater than
+ * QUECTEL_LX6_NMEA_INTERVAL_MAX, or if required sentences would be missing
+ * @retval -ENOSPC if the NMEA output would not fit within the link budget
+ * @retval -errno another negative errno code if the receiver could not be configured
+ */
+int quectel_lx6_set_nmea_interval(const struct device *dev, uint8_t sentences, uint8_t fixes);
+
+/**
+ * @brief Get the output interval of an NMEA0183 sentence
+ *
+ * @param dev Device instance
+ * @param sentence A single QUECTEL_LX6_NMEA_* sentence
+ * @param fixes Destination for output interval in number of fixes, 0 if disabled
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if not a single sentence
+ */
+int quectel_lx6_get_nmea_interval(const struct device *dev, uint8_t sentence, uint8_t *fixes);
+
+/**
+ * @brief Set the power mode of the receiver
+ *
+ * @details In periodic and AlwaysLocate modes, the receiver alternates between
+ * running and sleeping on its own, outputting sentences only while running. As
+ * commands are ignored while it sleeps, the driver brings the receiver back to
+ * full power before configuring or suspending it, which may take up to a sleep
+ * time in backup modes, then restores the power mode. The power mode is applied
+ * to the receiver like a profile setting.
+ *
+ * @note Commands sent with quectel_lx6_pmtk_submit() may time out while the
+ * receiver sleeps
+ *
+ * @param dev Device instance
+ * @param power Power mode settings, run and sleep times are only used by periodic modes
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if mode is unknown, or if run or sleep times are out of
+ * [QUECTEL_LX6_POWER_TIME_MIN_MS, QUECTEL_LX6_POWER_TIME_MAX_MS]
+ * @retval -errno another negative errno code if the receiver could not be configured
+ */
+int quectel_lx6_set_power_mode(const struct device *dev, const struct quectel_lx6_power *power);
+
+/**
+ * @brief Get the power mode of the receiver
+ *
+ * @param dev Device instance
+ * @param power Destination for power mode settings
+ *
+ * @retval 0 if successful
+ */
+int quectel_lx6_get_power_mode(const struct device *dev, struct quectel_lx6_power *power);
+
+/**
+ * @brief Restart the receiver
+ *
+ * @details Waits until the receiver reports its startup, then restores its power
+ * mode. All settings are replayed after a full cold restart, which resets the
+ * receiver to its factory settings. The time to first fix is measured from the
+ * restart command.
+ *
+ * @param dev Device instance
+ * @param restart Restart type, other than QUECTEL_LX6_RESTART_RESUME
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if restart type is invalid
+ * @retval -EIO if the receiver could not be switched back to its default speed before a full
+ * cold restart
+ * @retval -errno another negative errno code if the receiver could not be restarted
+ */
+int quectel_lx6_restart(const struct device *dev, enum quectel_lx6_restart restart);
+
+/**
+ * @brief Get time to first fix statistics of a restart type
+ *
+ * @details Each restart, or resume of the device, starts measuring the time until
+ * the first published epoch with a fix, and the first one whose HDOP does not
+ * exceed the threshold. Fixes dropped by the accuracy gate count. A measurement
+ * still in progress is abandoned by the next restart. HDOP is only reported by
+ * GGA sentences, so the HDOP measurement is skipped when they are not output.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_TTFF
+ *
+ * @param dev Device instance
+ * @param restart Restart type
+ * @param stats Destination for statistics
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if restart type is invalid
+ * @retval -ENOTSUP if time to first fix statistics are not supported
+ */
+int quectel_lx6_get_ttff_stats(const struct device *dev, enum quectel_lx6_restart restart,
+			       struct quectel_lx6_ttff_stats *stats);
+
+/**
+ * @brief Reset time to first fix statistics of all restart types
+ *
+ * @param dev Device instance
+ */
+void quectel_lx6_reset_ttff_stats(const struct device *dev);
+
+/**
+ * @brief Set the HDOP threshold of time to first fix measurements
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_TTFF
+ *
+ * @param dev Device instance
+ * @param hdop HDOP threshold in thousandths, like the GNSS API
+ *
+ * @retval 0 if successful
+ * @retval -ENOTSUP if time to first fix statistics are not supported
+ */
+int quectel_lx6_set_ttff_hdop(const struct device *dev, uint32_t hdop);
+
+/**
+ * @brief Get the utilization of the UART link to the receiver
+ *
+ * @details The worst case is estimated from the applied NMEA output, systems and
+ * fix rate. The measured rate requires CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER, it is
+ * 0 otherwise.
+ *
+ * @param dev Device instance
+ * @param budget Destination for link utilization
+ *
+ * @retval 0 if successful
+ */
+int quectel_lx6_get_link_budget(const struct device *dev, struct quectel_lx6_link_budget *budget);
+
+/**
+ * @brief Get epoch statistics
+ *
+ * @details Latencies are only measured with CONFIG_GNSS_QUECTEL_LX6_EPOCH_STATS,
+ * and the first byte of an epoch is only timestamped on reception with
+ * CONFIG_GNSS_QUECTEL_LX6_NMEA_FRAMER. Otherwise the epoch starts once its first
+ * sentence has been received.
+ *
+ * @param dev Device instance
+ * @param stats Destination for statistics
+ *
+ * @retval 0 if successful
+ */
+int quectel_lx6_get_epoch_stats(const struct device *dev, struct quectel_lx6_epoch_stats *stats);
+
+/**
+ * @brief Reset epoch statistics
+ *
+ * @param dev Device instance
+ */
+void quectel_lx6_reset_epoch_stats(const struct device *dev);
+
+/**
+ * @brief Get resume statistics
+ *
+ * @details The receiver is deemed ready after power on or a PM action once it
+ * outputs a valid sentence, like its $PMTK010 system messages, or at most
+ * 500 milliseconds later. Resuming and suspending wait until then, except for
+ * the first resume of a receiver powered along with the system.
+ *
+ * @param dev Device instance
+ * @param stats Destination for resume statistics
+ *
+ * @retval 0 if successful
+ */
+int quectel_lx6_get_resume_stats(const struct device *dev, struct quectel_lx6_resume_stats *stats);
+
+/**
+ * @brief Reset resume statistics
+ *
+ * @param dev Device instance
+ */
+void quectel_lx6_reset_resume_stats(const struct device *dev);
+
+/**
+ * @brief Remove the oldest fixes from history
+ *
+ * @details Published fixes are stored in history, the oldest ones being dropped
+ * once it is full. Epochs without fix are not stored.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_HISTORY
+ *
+ * @param dev Device instance
+ * @param fixes Destination for removed fixes, oldest first
+ * @param size Maximum number of fixes to remove
+ *
+ * @returns Number of fixes removed if successful
+ * @retval -ENOTSUP if history is not supported
+ */
+int quectel_lx6_history_drain(const struct device *dev, struct quectel_lx6_fix *fixes,
+			      size_t size);
+
+/**
+ * @brief Visit fixes stored in history, oldest first, without removing them
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_HISTORY
+ * @note Fixes are not stored while visited, the callback should be quick
+ *
+ * @param dev Device instance
+ * @param visit Callback invoked for every fix
+ * @param user_data User data passed to callback
+ *
+ * @returns Number of fixes visited if successful
+ * @retval -ENOTSUP if history is not supported
+ */
+int quectel_lx6_history_foreach(const struct device *dev, quectel_lx6_history_visit_t visit,
+				void *user_data);
+
+/**
+ * @brief Get the stack usage of the dedicated work queue
+ *
+ * @details The usage is the high-water mark of the stack since the work queue
+ * was started, which runs the GNSS data and satellites callbacks.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_WORKQ, CONFIG_INIT_STACKS and
+ * CONFIG_THREAD_STACK_INFO
+ *
+ * @param dev Device instance
+ * @param used Destination for the maximum number of stack bytes used
+ * @param size Destination for the size of the stack in bytes
+ *
+ * @retval 0 if successful
+ * @retval -ENOTSUP if dedicated work queue or stack usage is not supported
+ * @retval -errno another negative errno code if stack usage could not be measured
+ */
+int quectel_lx6_get_workq_stack_usage(const struct device *dev, size_t *used, size_t *size);
+
+/**
+ * @brief Validate a receiver profile without applying it
+ *
+ * @details The NMEA output may only contain sentences handled by the driver, and
+ * must contain the sentences required in epochs, at least one of which must be
+ * output every fix. Once merged with the applied settings, the worst case NMEA
+ * output must fit within CONFIG_GNSS_QUECTEL_LX6_LINK_BUDGET percent of the
+ * link, unless it doesn't grow. The GNSS API setters are validated likewise.
+ *
+ * @param dev Device instance
+ * @param profile Profile to validate
+ *
+ * @retval 0 if profile is valid
+ * @retval -EINVAL if any staged setting is invalid
+ * @retval -ENOSPC if the NMEA output would not fit within the link budget
+ */
+int quectel_lx6_validate_profile(const struct device *dev,
+				 const struct quectel_lx6_profile *profile);
+
+/**
+ * @brief Apply the settings staged in a receiver profile
+ *
+ * @details The commands of all staged settings are written at once, then their
+ * acknowledgements are awaited in order. Settings whose value is already
+ * applied are skipped. Once applied, settings are replayed whenever the device
+ * is resumed or exits standby mode. The GNSS API setters apply single setting
+ * profiles.
+ *
+ * @note If applying fails, the receiver may be partially configured
+ *
+ * @param dev Device instance
+ * @param profile Profile to apply
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if any staged setting is invalid
+ * @retval -ENOSPC if the NMEA output would not fit within the link budget
+ * @retval -errno another negative errno code if the receiver could not be configured
+ */
+int quectel_lx6_apply_profile(const struct device *dev, const struct quectel_lx6_profile *profile);
+
+/**
+ * @brief Get the settings applied to the receiver, replayed on resume
+ *
+ * @details Answered from the cache without any round trip. The NMEA output and
+ * PPS settings are always flagged, the power mode is flagged if set in the
+ * devicetree, other settings are flagged once applied.
+ *
+ * @param dev Device instance
+ * @param profile Destination for applied settings
+ *
+ * @retval 0 if successful
+ */
+int quectel_lx6_get_profile(const struct device *dev, struct quectel_lx6_profile *profile);
+
+/**
+ * @brief Query the receiver for the applied settings it is able to report
+ *
+ * @details Settings are cached once acknowledged by the receiver, from which the
+ * GNSS API getters answer without any round trip. This may be used to resync the
+ * cache if the receiver could have been configured behind the driver's back.
+ * Only enabled systems can be queried, SBAS excluded, and are refreshed if
+ * they have been applied before. QZSS, which can't be configured, is left out
+ * so that the cached profile can be applied again.
+ *
+ * @param dev Device instance
+ *
+ * @retval 0 if successful
+ * @retval -errno negative errno code if the receiver could not be queried
+ */
+int quectel_lx6_refresh_profile(const struct device *dev);
+
+/**
+ * @brief Callback invoked once a PMTK command is completed
+ *
+ * @param dev Device instance
+ * @param result 0 if acknowledged as successful, negative errno code otherwise
+ * @param user_data User data given along with the command
+ */
+typedef void (*quectel_lx6_pmtk_handler_t)(const struct device *dev, int result,
+					   void *user_data);
+
+/**
+ * @brief Send a PMTK command without waiting for its acknowledgement
+ *
+ * @details Commands are queued and written back-to-back, each one completed
+ * once its $PMTK001 acknowledgement is received. The result is 0 if the command
+ * succeeded, -EINVAL if invalid, -ENOTSUP if unsupported, -EIO if failed,
+ * -ETIMEDOUT if not acknowledged in time or -ECANCELED if the device was powered
+ * off. Once completed, the handler is invoked from the context receiving data
+ * and the signal is raised with the result.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE, and CONFIG_POLL for signals
+ * @note Commands answered with another sentence than $PMTK001 time out
+ * @note Configuring the device waits for written commands to be completed
+ *
+ * @param dev Device instance
+ * @param command Command without '$' and checksum, like "PMTK220,200"
+ * @param timeout_ms Time allowed for acknowledgement once written
+ * @param handler Handler invoked once completed, may be NULL
+ * @param user_data User data passed to handler
+ * @param signal Signal raised once completed, may be NULL
+ *
+ * @retval 0 if queued
+ * @retval -EINVAL if command is not a PMTK command
+ * @retval -ENOMEM if command is too long
+ * @retval -ENOBUFS if queue is full
+ * @retval -ENOTSUP if asynchronous PMTK commands are not supported
+ */
+int quectel_lx6_pmtk_submit(const struct device *dev, const char *command, uint32_t timeout_ms,
+			    quectel_lx6_pmtk_handler_t handler, void *user_data,
+			    struct k_poll_signal *signal);
+
+/**
+ * @brief Register a satellite delta callback
+ *
+ * @details Instead of the whole sky view, the handler receives the satellites
+ * which have been added, removed, or whose tracking state, SNR or elevation
+ * changed beyond hysteresis since they were last notified. The changes of a sky
+ * view may be split into several calls. The handler is invoked from the thread
+ * parsing the sentences and must not block.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+ *
+ * @param dev Device instance
+ * @param cb Callback to register, must remain valid until removed
+ *
+ * @retval 0 if successful
+ * @retval -EALREADY if callback is already registered
+ * @retval -ENOTSUP if satellite table is not supported
+ */
+int quectel_lx6_add_satellite_callback(const struct device *dev,
+				       struct quectel_lx6_satellite_callback *cb);
+
+/**
+ * @brief Remove a satellite delta callback
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_SAT_TABLE
+ *
+ * @param dev Device instance
+ * @param cb Callback to remove
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if callback is not registered
+ * @retval -ENOTSUP if satellite table is not supported
+ */
+int quectel_lx6_remove_satellite_callback(const struct device *dev,
+					  struct quectel_lx6_satellite_callback *cb);
+
+/**
+ * @brief Register a data callback with delivery policy
+ *
+ * @details The policy is evaluated once per published epoch, after the GNSS data
+ * callbacks. It may be changed while registered. The handler is invoked from the
+ * thread parsing the sentences and must not block.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+ *
+ * @param dev Device instance
+ * @param cb Callback to register, must remain valid until removed
+ *
+ * @retval 0 if successful
+ * @retval -EALREADY if callback is already registered
+ * @retval -ENOTSUP if data callbacks are not supported
+ */
+int quectel_lx6_add_data_callback(const struct device *dev, struct quectel_lx6_data_callback *cb);
+
+/**
+ * @brief Remove a data callback
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_DATA_POLICY
+ *
+ * @param dev Device instance
+ * @param cb Callback to remove
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if callback is not registered
+ * @retval -ENOTSUP if data callbacks are not supported
+ */
+int quectel_lx6_remove_data_callback(const struct device *dev,
+				     struct quectel_lx6_data_callback *cb);
+
+/**
+ * @brief Register a satellite stream callback
+ *
+ * @details The satellites of every GSV sentence are passed to the handler as
+ * soon as the sentence is parsed. The chunks of a sky view, which contains the
+ * satellites of all systems, are delimited by the start and end markers. The
+ * handler is invoked from the thread parsing the sentences and must not block.
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+ *
+ * @param dev Device instance
+ * @param cb Callback to register, must remain valid until removed
+ *
+ * @retval 0 if successful
+ * @retval -EALREADY if callback is already registered
+ * @retval -ENOTSUP if satellites are not streamed
+ */
+int quectel_lx6_add_satellite_stream_callback(const struct device *dev,
+					      struct quectel_lx6_satellite_stream_callback *cb);
+
+/**
+ * @brief Remove a satellite stream callback
+ *
+ * @note Requires CONFIG_GNSS_QUECTEL_LX6_SAT_STREAM
+ *
+ * @param dev Device instance
+ * @param cb Callback to remove
+ *
+ * @retval 0 if successful
+ * @retval -EINVAL if callback is not registered
+ * @retval -ENOTSUP if satellites are not streamed
+ */
+int quectel_lx6_remove_satellite_stream_callback(
+	const struct device *dev, struct quectel_lx6_satellite_stream_callback *cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_GNSS_QUECTEL_LX6_H_ */
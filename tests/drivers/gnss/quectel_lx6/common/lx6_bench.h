@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Time measurement for the benchmark suites. The kernel clock of native_sim
+ * only advances while the CPU idles, so the host clock of the native C library
+ * is used there instead. Benchmark suites are skipped when neither is usable.
+ */
+
+#ifndef LX6_BENCH_H_
+#define LX6_BENCH_H_
+
+#include <zephyr/kernel.h>
+
+#if CONFIG_NATIVE_LIBC
+#include <time.h>
+#endif
+
+#define LX6_BENCH_ENABLED (IS_ENABLED(CONFIG_NATIVE_LIBC) || !IS_ENABLED(CONFIG_ARCH_POSIX))
+
+static inline bool lx6_bench_predicate(const void *state)
+{
+	ARG_UNUSED(state);
+
+	return LX6_BENCH_ENABLED;
+}
+
+#if CONFIG_NATIVE_LIBC
+static inline uint64_t lx6_bench_host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + ts.tv_nsec;
+}
+#endif
+
+/* Take a timestamp to measure from */
+static inline uint64_t lx6_bench_start(void)
+{
+#if CONFIG_NATIVE_LIBC
+	return lx6_bench_host_ns();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+/* Get the nanoseconds elapsed since a timestamp */
+static inline uint64_t lx6_bench_elapsed_ns(uint64_t start)
+{
+#if CONFIG_NATIVE_LIBC
+	return lx6_bench_host_ns() - start;
+#else
+	return k_cyc_to_ns_floor64(k_cycle_get_32() - (uint32_t)start);
+#endif
+}
+
+#endif /* LX6_BENCH_H_ */
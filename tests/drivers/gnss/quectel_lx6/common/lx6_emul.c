@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gnss_nmea0183.h"
+#include "lx6_emul.h"
+
+#define LX6_EMUL_LINE_SIZE  (128)
+#define LX6_EMUL_FAILS_MAX  (4)
+#define LX6_EMUL_FLAG_VALID (3)
+#define LX6_EMUL_FLAG_FAIL  (2)
+#define LX6_EMUL_PMTK_SPEED (251)
+
+#define LX6_EMUL_PMTK_HOT_RESTART       (101)
+#define LX6_EMUL_PMTK_FULL_COLD_RESTART (104)
+
+static const struct device *lx6_emul_uart;
+static struct k_spinlock lx6_emul_lock;
+
+/* Line being received from the driver */
+static char lx6_emul_line[LX6_EMUL_LINE_SIZE];
+static size_t lx6_emul_line_size;
+
+static char lx6_emul_commands[LX6_EMUL_COMMANDS_MAX][LX6_EMUL_LINE_SIZE];
+static size_t lx6_emul_commands_size;
+
+static uint16_t lx6_emul_fails[LX6_EMUL_FAILS_MAX];
+static size_t lx6_emul_fails_size;
+
+/* Speed the receiver runs at, 0 if it follows the UART */
+static uint32_t lx6_emul_speed;
+static uint32_t lx6_emul_default_speed;
+
+void lx6_emul_send(const char *body)
+{
+	char reply[LX6_EMUL_LINE_SIZE];
+	int ret;
+
+	ret = lx6_nmea0183_snprintk(reply, sizeof(reply) - 2, "%s", body);
+	if (ret < 0) {
+		return;
+	}
+
+	memcpy(&reply[ret], "\r\n", 2);
+	(void)uart_emul_put_rx_data(lx6_emul_uart, (const uint8_t *)reply, ret + 2);
+}
+
+static bool lx6_emul_failing(uint16_t command)
+{
+	for (size_t i = 0; i < lx6_emul_fails_size; i++) {
+		if (lx6_emul_fails[i] == command) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Lines written at another speed than the receiver's are garbled */
+static bool lx6_emul_speed_matches(void)
+{
+	struct uart_config uart_config;
+
+	if ((lx6_emul_speed == 0) || (uart_config_get(lx6_emul_uart, &uart_config) < 0)) {
+		return true;
+	}
+
+	return uart_config.baudrate == lx6_emul_speed;
+}
+
+/*
+ * Record a PMTK command and acknowledge it, $PMTK000 tests the link. PMTK251
+ * switches the speed of the receiver instead, and is not acknowledged. Restarts
+ * are answered with the startup message, a full cold restart reverting to the
+ * default speed.
+ */
+static void lx6_emul_handle_line(void)
+{
+	k_spinlock_key_t key;
+	uint16_t command;
+	char body[24];
+	uint8_t flag;
+	char *end;
+	char *arg;
+
+	if ((lx6_emul_line_size < 6) || (strncmp(lx6_emul_line, "$PMTK", 5) != 0)) {
+		return;
+	}
+
+	end = strchr(lx6_emul_line, '*');
+	if (end == NULL) {
+		return;
+	}
+
+	*end = '\0';
+	command = (uint16_t)strtoul(&lx6_emul_line[5], &arg, 10);
+
+	key = k_spin_lock(&lx6_emul_lock);
+
+	if (!lx6_emul_speed_matches()) {
+		k_spin_unlock(&lx6_emul_lock, key);
+		return;
+	}
+
+	if (lx6_emul_commands_size < LX6_EMUL_COMMANDS_MAX) {
+		strcpy(lx6_emul_commands[lx6_emul_commands_size], &lx6_emul_line[1]);
+		lx6_emul_commands_size++;
+	}
+
+	flag = lx6_emul_failing(command) ? LX6_EMUL_FLAG_FAIL : LX6_EMUL_FLAG_VALID;
+
+	if (command == LX6_EMUL_PMTK_SPEED) {
+		if ((flag == LX6_EMUL_FLAG_VALID) && (*arg == ',')) {
+			lx6_emul_speed = strtoul(&arg[1], NULL, 10);
+		}
+
+		k_spin_unlock(&lx6_emul_lock, key);
+		return;
+	}
+
+	if (IN_RANGE(command, LX6_EMUL_PMTK_HOT_RESTART, LX6_EMUL_PMTK_FULL_COLD_RESTART)) {
+		if ((command == LX6_EMUL_PMTK_FULL_COLD_RESTART) && (lx6_emul_speed != 0)) {
+			lx6_emul_speed = lx6_emul_default_speed;
+		}
+
+		k_spin_unlock(&lx6_emul_lock, key);
+		lx6_emul_send("PMTK010,001");
+		return;
+	}
+
+	k_spin_unlock(&lx6_emul_lock, key);
+
+	snprintk(body, sizeof(body), "PMTK001,%u,%u", command, flag);
+	lx6_emul_send(body);
+}
+
+static void lx6_emul_tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	uint8_t byte;
+
+	ARG_UNUSED(size);
+	ARG_UNUSED(user_data);
+
+	while (uart_emul_get_tx_data(dev, &byte, 1) == 1) {
+		if (byte == '\r') {
+			continue;
+		}
+
+		if (byte == '\n') {
+			lx6_emul_line[lx6_emul_line_size] = '\0';
+			lx6_emul_handle_line();
+			lx6_emul_line_size = 0;
+			continue;
+		}
+
+		/* Overlong lines are truncated, and thus dropped once their checksum is missing */
+		if (lx6_emul_line_size < (sizeof(lx6_emul_line) - 1)) {
+			lx6_emul_line[lx6_emul_line_size++] = (char)byte;
+		}
+	}
+}
+
+void lx6_emul_init(const struct device *uart)
+{
+	struct uart_config uart_config;
+
+	lx6_emul_uart = uart;
+	lx6_emul_reset();
+
+	/* Receiver starts at the default speed of the UART */
+	if (uart_config_get(uart, &uart_config) == 0) {
+		lx6_emul_default_speed = uart_config.baudrate;
+	}
+
+	lx6_emul_set_speed(lx6_emul_default_speed);
+	uart_emul_callback_tx_data_ready_set(uart, lx6_emul_tx_data_ready, NULL);
+}
+
+void lx6_emul_reset(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lx6_emul_lock);
+	lx6_emul_commands_size = 0;
+	lx6_emul_fails_size = 0;
+	k_spin_unlock(&lx6_emul_lock, key);
+}
+
+void lx6_emul_fail(uint16_t command)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lx6_emul_lock);
+	if (lx6_emul_fails_size < ARRAY_SIZE(lx6_emul_fails)) {
+		lx6_emul_fails[lx6_emul_fails_size++] = command;
+	}
+	k_spin_unlock(&lx6_emul_lock, key);
+}
+
+void lx6_emul_set_speed(uint32_t speed)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lx6_emul_lock);
+	lx6_emul_speed = speed;
+	k_spin_unlock(&lx6_emul_lock, key);
+}
+
+uint32_t lx6_emul_get_speed(void)
+{
+	k_spinlock_key_t key;
+	uint32_t speed;
+
+	key = k_spin_lock(&lx6_emul_lock);
+	speed = lx6_emul_speed;
+	k_spin_unlock(&lx6_emul_lock, key);
+	return speed;
+}
+
+size_t lx6_emul_count(void)
+{
+	k_spinlock_key_t key;
+	size_t count;
+
+	key = k_spin_lock(&lx6_emul_lock);
+	count = lx6_emul_commands_size;
+	k_spin_unlock(&lx6_emul_lock, key);
+	return count;
+}
+
+const char *lx6_emul_command(size_t index)
+{
+	if (index >= lx6_emul_count()) {
+		return "";
+	}
+
+	return lx6_emul_commands[index];
+}
+
+uint16_t lx6_emul_command_id(size_t index)
+{
+	const char *command = lx6_emul_command(index);
+
+	if (strncmp(command, "PMTK", 4) != 0) {
+		return UINT16_MAX;
+	}
+
+	return (uint16_t)strtoul(&command[4], NULL, 10);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LX6_EMUL_H_
+#define LX6_EMUL_H_
+
+#include <zephyr/device.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Most commands recorded between resets */
+#define LX6_EMUL_COMMANDS_MAX 16
+
+/**
+ * @brief Emulate a receiver behind an emulated UART
+ *
+ * @details Every PMTK command written to the UART is recorded, then acknowledged
+ * as successful unless it has been made to fail. Commands written while the UART
+ * is at another speed than the receiver are lost. The receiver starts at the
+ * speed of the UART, then follows PMTK251 without acknowledging it. Restarts are
+ * answered with the $PMTK010 startup message, a full cold restart reverting to
+ * the speed the receiver started at.
+ *
+ * @param uart Emulated UART the driver is attached to
+ */
+void lx6_emul_init(const struct device *uart);
+
+/** @brief Forget the recorded commands and make all commands succeed again */
+void lx6_emul_reset(void);
+
+/** @brief Acknowledge a PMTK command as failed from now on, PMTK251 being ignored instead */
+void lx6_emul_fail(uint16_t command);
+
+/** @brief Set the speed the receiver runs at, as once power cycled, 0 to follow the UART */
+void lx6_emul_set_speed(uint32_t speed);
+
+/** @brief Get the speed the receiver runs at */
+uint32_t lx6_emul_get_speed(void);
+
+/**
+ * @brief Send a sentence from the receiver, as it outputs NMEA0183 sentences
+ *
+ * @param body Sentence without its leading '$' and checksum, like "GPGGA,..."
+ */
+void lx6_emul_send(const char *body);
+
+/** @brief Get the number of commands recorded since the last reset */
+size_t lx6_emul_count(void);
+
+/**
+ * @brief Get a recorded command
+ *
+ * @param index Index of the command, in the order it was received
+ *
+ * @return Command without its leading '$' and checksum, like "PMTK220,1000", or an
+ * empty string if there is no such command
+ */
+const char *lx6_emul_command(size_t index);
+
+/** @brief Get the PMTK number of a recorded command, UINT16_MAX if there is none */
+uint16_t lx6_emul_command_id(size_t index);
+
+#endif /* LX6_EMUL_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gnss/quectel_lx6.h>
+#include <zephyr/ztest.h>
+
+#include "lx6_emul.h"
+
+static const struct device *gnss = DEVICE_DT_GET(DT_NODELABEL(gnss));
+
+static void *setup(void)
+{
+	/* Device is initialized by whichever suite runs first */
+	if (!device_is_ready(gnss)) {
+		lx6_emul_init(DEVICE_DT_GET(DT_NODELABEL(euart0)));
+		zassert_ok(device_init(gnss));
+	}
+
+	return NULL;
+}
+
+/* Let modem chat process the sentences sent by the receiver */
+static void receive(void)
+{
+	k_sleep(K_MSEC(100));
+}
+
+ZTEST(lx6_driver_nmea, test_sentences_published)
+{
+	struct gnss_data latest;
+
+	lx6_emul_send("GPGGA,123519.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+	lx6_emul_send("GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A");
+	receive();
+
+	/* Fields are parsed from the right arguments */
+	zassert_ok(quectel_lx6_get_latest_fix(gnss, &latest));
+	zassert_equal(latest.info.fix_status, GNSS_FIX_STATUS_GNSS_FIX);
+	zassert_equal(latest.info.satellites_cnt, 8);
+	zassert_within(latest.nav_data.latitude, 48117300000LL, 1);
+	zassert_within(latest.nav_data.longitude, 11516666666LL, 1);
+	zassert_equal(latest.utc.hour, 12);
+	zassert_equal(latest.utc.minute, 35);
+	zassert_equal(latest.utc.month, 3);
+}
+
+ZTEST(lx6_driver_nmea, test_other_talkers_published)
+{
+	struct gnss_data latest;
+
+	/* Multi-constellation receivers report combined fixes with the GN talker */
+	lx6_emul_send("GNGGA,123520.00,4807.038,N,01131.000,E,1,12,0.8,545.4,M,46.9,M,,");
+	lx6_emul_send("GNRMC,123520.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A");
+	receive();
+
+	zassert_ok(quectel_lx6_get_latest_fix(gnss, &latest));
+	zassert_equal(latest.info.satellites_cnt, 12);
+	zassert_equal(latest.utc.millisecond, 20000);
+}
+
+ZTEST_SUITE(lx6_driver_nmea, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gnss/quectel_lx6.h>
+#include <zephyr/ztest.h>
+
+#include "lx6_emul.h"
+
+#define PMTK_PROBE    0
+#define PMTK_FIX_RATE 220
+
+#define PMTK_TIMEOUT_MS 1000
+
+static const struct device *gnss = DEVICE_DT_GET(DT_NODELABEL(gnss));
+
+static int pmtk_result;
+static uint8_t pmtk_completed;
+
+static void pmtk_handler(const struct device *dev, int result, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	pmtk_result = result;
+	pmtk_completed++;
+}
+
+static bool pmtk_queue_enabled(const void *global_state)
+{
+	ARG_UNUSED(global_state);
+
+	return IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_PMTK_QUEUE);
+}
+
+static void *setup(void)
+{
+	/* Device is initialized by whichever suite runs first */
+	if (!device_is_ready(gnss)) {
+		lx6_emul_init(DEVICE_DT_GET(DT_NODELABEL(euart0)));
+		zassert_ok(device_init(gnss));
+	}
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	lx6_emul_reset();
+	pmtk_result = -EINPROGRESS;
+	pmtk_completed = 0;
+}
+
+/* Let the queue write commands and the framer receive their acknowledgements */
+static void receive(void)
+{
+	k_sleep(K_MSEC(100));
+}
+
+ZTEST(lx6_driver_pmtk, test_command_acknowledged)
+{
+	zassert_ok(quectel_lx6_pmtk_submit(gnss, "PMTK000", PMTK_TIMEOUT_MS, pmtk_handler, NULL,
+					   NULL));
+	receive();
+
+	zassert_equal(pmtk_completed, 1);
+	zassert_ok(pmtk_result);
+	zassert_equal(lx6_emul_command_id(0), PMTK_PROBE);
+}
+
+ZTEST(lx6_driver_pmtk, test_command_failure_reported)
+{
+	lx6_emul_fail(PMTK_PROBE);
+	zassert_ok(quectel_lx6_pmtk_submit(gnss, "PMTK000", PMTK_TIMEOUT_MS, pmtk_handler, NULL,
+					   NULL));
+	receive();
+
+	zassert_equal(pmtk_completed, 1);
+	zassert_equal(pmtk_result, -EIO);
+}
+
+ZTEST(lx6_driver_pmtk, test_scripts_acknowledged)
+{
+	struct quectel_lx6_profile profile;
+
+	/* Script gets its own acknowledgement while a command is queued */
+	zassert_ok(quectel_lx6_pmtk_submit(gnss, "PMTK000", PMTK_TIMEOUT_MS, pmtk_handler, NULL,
+					   NULL));
+
+	zassert_ok(quectel_lx6_get_profile(gnss, &profile));
+	profile.settings = QUECTEL_LX6_PROFILE_FIX_RATE;
+	profile.fix_interval_ms = (profile.fix_interval_ms == 1000) ? 500 : 1000;
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	receive();
+
+	/* Queued command is not mistaken for the one of the script */
+	zassert_equal(pmtk_completed, 1);
+	zassert_ok(pmtk_result);
+	zassert_equal(lx6_emul_count(), 2);
+	zassert_true((lx6_emul_command_id(0) == PMTK_FIX_RATE) ||
+		     (lx6_emul_command_id(1) == PMTK_FIX_RATE));
+}
+
+ZTEST_SUITE(lx6_driver_pmtk, pmtk_queue_enabled, setup, before, NULL, NULL);
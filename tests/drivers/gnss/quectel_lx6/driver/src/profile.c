@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gnss/quectel_lx6.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/ztest.h>
+
+#include "lx6_emul.h"
+
+#define PMTK_PROBE    0
+#define PMTK_STANDBY  161
+#define PMTK_FIX_RATE 220
+#define PMTK_PPS      285
+#define PMTK_SBAS     313
+#define PMTK_NMEA     314
+#define PMTK_SEARCH   353
+#define PMTK_NAV_MODE 886
+
+static const struct device *gnss = DEVICE_DT_GET(DT_NODELABEL(gnss));
+
+/* Settings applied before each test, beside the NMEA output and PPS applied at init */
+static const struct quectel_lx6_profile baseline = {
+	.settings = QUECTEL_LX6_PROFILE_FIX_RATE | QUECTEL_LX6_PROFILE_NAVIGATION_MODE |
+		    QUECTEL_LX6_PROFILE_SYSTEMS,
+	.fix_interval_ms = 1000,
+	.navigation_mode = GNSS_NAVIGATION_MODE_BALANCED_DYNAMICS,
+	.systems = GNSS_SYSTEM_GPS | GNSS_SYSTEM_GLONASS,
+};
+
+/* Exit from standby mode, then every applied setting replayed in a single batch */
+static const uint16_t resume_commands[] = {PMTK_PROBE,  PMTK_NMEA, PMTK_FIX_RATE, PMTK_NAV_MODE,
+					   PMTK_SEARCH, PMTK_SBAS, PMTK_PPS};
+
+/* Check the commands received since the last reset, in order */
+static void assert_sent(const uint16_t *commands, size_t size)
+{
+	zassert_equal(lx6_emul_count(), size, "%zu commands sent", lx6_emul_count());
+
+	for (size_t i = 0; i < size; i++) {
+		zassert_equal(lx6_emul_command_id(i), commands[i], "%s", lx6_emul_command(i));
+	}
+}
+
+static void assert_applied(const struct quectel_lx6_profile *expected)
+{
+	struct quectel_lx6_profile profile;
+
+	zassert_ok(quectel_lx6_get_profile(gnss, &profile));
+	zassert_equal(profile.settings & expected->settings, expected->settings);
+	zassert_equal(profile.fix_interval_ms, expected->fix_interval_ms);
+	zassert_equal(profile.navigation_mode, expected->navigation_mode);
+	zassert_equal(profile.systems, expected->systems);
+}
+
+static void *setup(void)
+{
+	/* Device is initialized by whichever suite runs first */
+	if (!device_is_ready(gnss)) {
+		lx6_emul_init(DEVICE_DT_GET(DT_NODELABEL(euart0)));
+		zassert_ok(device_init(gnss));
+	}
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	lx6_emul_reset();
+	zassert_ok(quectel_lx6_apply_profile(gnss, &baseline));
+	lx6_emul_reset();
+}
+
+ZTEST(lx6_driver_profile, test_profile_reported)
+{
+	struct quectel_lx6_profile profile;
+
+	/* NMEA output and PPS are always applied */
+	zassert_ok(quectel_lx6_get_profile(gnss, &profile));
+	zassert_equal(profile.settings, QUECTEL_LX6_PROFILE_NMEA_OUTPUT | QUECTEL_LX6_PROFILE_PPS |
+					baseline.settings);
+	assert_applied(&baseline);
+}
+
+ZTEST(lx6_driver_profile, test_applied_settings_skipped)
+{
+	struct quectel_lx6_profile profile = baseline;
+	static const uint16_t nav_mode[] = {PMTK_NAV_MODE};
+
+	/* Nothing is sent again */
+	zassert_ok(quectel_lx6_apply_profile(gnss, &baseline));
+	assert_sent(NULL, 0);
+
+	/* Only the setting which changed is sent */
+	profile.navigation_mode = GNSS_NAVIGATION_MODE_HIGH_DYNAMICS;
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	assert_sent(nav_mode, ARRAY_SIZE(nav_mode));
+	zassert_str_equal(lx6_emul_command(0), "PMTK886,2");
+	assert_applied(&profile);
+
+	lx6_emul_reset();
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	assert_sent(NULL, 0);
+
+	/* Neither does a single setting profile send the others */
+	profile.settings = QUECTEL_LX6_PROFILE_FIX_RATE;
+	profile.fix_interval_ms = 500;
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	zassert_equal(lx6_emul_count(), 1);
+	zassert_str_equal(lx6_emul_command(0), "PMTK220,500");
+}
+
+ZTEST(lx6_driver_profile, test_partial_failure)
+{
+	struct quectel_lx6_profile profile = baseline;
+	static const uint16_t batch[] = {PMTK_FIX_RATE, PMTK_NAV_MODE, PMTK_SEARCH, PMTK_SBAS};
+
+	profile.fix_interval_ms = 500;
+	profile.navigation_mode = GNSS_NAVIGATION_MODE_LOW_DYNAMICS;
+	profile.systems = GNSS_SYSTEM_GPS | GNSS_SYSTEM_GALILEO | GNSS_SYSTEM_SBAS;
+
+	/* Receiver acknowledges the other commands of the batch */
+	lx6_emul_fail(PMTK_NAV_MODE);
+	zassert_true(quectel_lx6_apply_profile(gnss, &profile) < 0);
+	assert_sent(batch, ARRAY_SIZE(batch));
+
+	/* None of the settings is recorded as applied, so all of them are sent again */
+	assert_applied(&baseline);
+
+	lx6_emul_reset();
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	assert_sent(batch, ARRAY_SIZE(batch));
+	assert_applied(&profile);
+}
+
+ZTEST(lx6_driver_profile, test_resume_replays_profile)
+{
+	struct quectel_lx6_profile profile = baseline;
+	static const uint16_t suspend[] = {PMTK_STANDBY};
+
+	profile.settings = QUECTEL_LX6_PROFILE_FIX_RATE;
+	profile.fix_interval_ms = 500;
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+	assert_sent(suspend, ARRAY_SIZE(suspend));
+
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	assert_sent(resume_commands, ARRAY_SIZE(resume_commands));
+	zassert_str_equal(lx6_emul_command(2), "PMTK220,500");
+	zassert_str_equal(lx6_emul_command(3), "PMTK886,0");
+	zassert_str_equal(lx6_emul_command(5), "PMTK313,0");
+
+	/* Replay does not count as a change */
+	lx6_emul_reset();
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	assert_sent(NULL, 0);
+}
+
+ZTEST(lx6_driver_profile, test_resume_failure_reported)
+{
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+
+	/* Receiver rejects the replayed fix rate */
+	lx6_emul_fail(PMTK_FIX_RATE);
+	zassert_true(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME) < 0);
+
+	/* Profile is kept, so the next resume replays it again */
+	assert_applied(&baseline);
+
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	assert_sent(resume_commands, ARRAY_SIZE(resume_commands));
+	zassert_str_equal(lx6_emul_command(2), "PMTK220,1000");
+}
+
+ZTEST(lx6_driver_profile, test_epoch_required_validated)
+{
+	const uint8_t required = QUECTEL_LX6_NMEA_GGA | QUECTEL_LX6_NMEA_RMC;
+
+	zassert_ok(quectel_lx6_set_epoch_required(gnss, required));
+	zassert_equal(quectel_lx6_set_epoch_required(gnss, 0), -EINVAL);
+	zassert_equal(quectel_lx6_set_epoch_required(gnss, QUECTEL_LX6_NMEA_GSV), -EINVAL);
+
+	/* Sentences which are not output can't be required */
+	zassert_ok(quectel_lx6_set_epoch_required(gnss, QUECTEL_LX6_NMEA_GGA));
+	zassert_ok(quectel_lx6_set_nmea_interval(gnss, QUECTEL_LX6_NMEA_RMC, 0));
+	zassert_equal(quectel_lx6_set_epoch_required(gnss, required), -EINVAL);
+	zassert_equal(quectel_lx6_set_epoch_required(gnss, QUECTEL_LX6_NMEA_RMC), -EINVAL);
+
+	/* Nor can sentences which are all output every few fixes only */
+	zassert_ok(quectel_lx6_set_nmea_interval(gnss, QUECTEL_LX6_NMEA_RMC, 2));
+	zassert_equal(quectel_lx6_set_epoch_required(gnss, QUECTEL_LX6_NMEA_RMC), -EINVAL);
+	zassert_ok(quectel_lx6_set_epoch_required(gnss, required));
+
+	/* Neither can the required sentences be left out of the output afterwards */
+	zassert_equal(quectel_lx6_set_nmea_interval(gnss, QUECTEL_LX6_NMEA_GGA, 2), -EINVAL);
+	zassert_equal(quectel_lx6_set_nmea_interval(gnss, QUECTEL_LX6_NMEA_RMC, 0), -EINVAL);
+
+	zassert_ok(quectel_lx6_set_nmea_interval(gnss, QUECTEL_LX6_NMEA_RMC, 1));
+}
+
+ZTEST_SUITE(lx6_driver_profile, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include <string.h>
+
+#include "gnss_history.h"
+
+/* Smallest ring accepted, holding a single record of the largest size */
+#define HISTORY_BUF_SIZE_MIN (60)
+#define HISTORY_PUSHES_MAX   (2000)
+
+static uint8_t history_buf[1024];
+static struct gnss_history history;
+
+/* Every pushed fix, the stored ones being the last pushed */
+static struct gnss_history_fix pushed[HISTORY_PUSHES_MAX];
+static size_t pushed_count;
+
+static uint32_t random_state;
+
+struct visit_context {
+	size_t first;
+	size_t visited;
+	size_t stop_after;
+	bool equal;
+};
+
+static uint32_t random_next(void)
+{
+	random_state = (random_state * 1103515245U) + 12345U;
+	return random_state;
+}
+
+static void history_init(uint16_t buf_size)
+{
+	const struct gnss_history_config config = {
+		.buf = history_buf,
+		.buf_size = buf_size,
+	};
+
+	zassert_ok(gnss_history_init(&history, &config));
+}
+
+/* Fix following the given one, every 16th being a jump taking the largest records */
+static void fix_next(struct gnss_history_fix *fix)
+{
+	if ((random_next() % 16) == 0) {
+		fix->timestamp_ms = ~fix->timestamp_ms;
+		fix->latitude = (int64_t)(((uint64_t)random_next() << 32) | random_next());
+		fix->longitude = ~fix->longitude;
+		fix->altitude = (fix->altitude < 0) ? INT32_MAX : INT32_MIN;
+		fix->speed = ~fix->speed;
+		fix->bearing = random_next();
+		return;
+	}
+
+	fix->timestamp_ms += 1000;
+	fix->latitude = (int64_t)((uint64_t)fix->latitude + (random_next() % 4001) - 2000);
+	fix->longitude = (int64_t)((uint64_t)fix->longitude + (random_next() % 4001) - 2000);
+	fix->altitude = (int32_t)((uint32_t)fix->altitude + (random_next() % 201) - 100);
+	fix->speed += (random_next() % 101) - 50;
+	fix->bearing = random_next() % 360000;
+}
+
+static void push(const struct gnss_history_fix *fix)
+{
+	zassert_true(pushed_count < ARRAY_SIZE(pushed));
+
+	gnss_history_push(&history, fix);
+	pushed[pushed_count++] = *fix;
+}
+
+static void push_next(void)
+{
+	struct gnss_history_fix fix = (pushed_count > 0) ? pushed[pushed_count - 1]
+							 : (struct gnss_history_fix){0};
+
+	fix_next(&fix);
+	push(&fix);
+}
+
+static bool visit(const struct gnss_history_fix *fix, void *user_data)
+{
+	struct visit_context *context = user_data;
+
+	if (memcmp(fix, &pushed[context->first + context->visited], sizeof(*fix)) != 0) {
+		context->equal = false;
+	}
+
+	context->visited++;
+	return context->visited != context->stop_after;
+}
+
+/* Check the stored fixes are the last pushed ones, oldest first */
+static void assert_stored(void)
+{
+	size_t count = gnss_history_count(&history);
+	struct visit_context context = {
+		.first = pushed_count - count,
+		.equal = true,
+	};
+
+	zassert_true(count <= pushed_count);
+	zassert_equal(gnss_history_foreach(&history, visit, &context), count);
+	zassert_equal(context.visited, count);
+	zassert_true(context.equal, "fixes differ after %zu pushes", pushed_count);
+}
+
+/* Drain up to size fixes, checking they are the oldest stored ones */
+static size_t drain(size_t size)
+{
+	struct gnss_history_fix fixes[8];
+	size_t count = gnss_history_count(&history);
+	size_t drained;
+
+	zassert_true(size <= ARRAY_SIZE(fixes));
+
+	drained = gnss_history_drain(&history, fixes, size);
+	zassert_equal(drained, MIN(size, count));
+	zassert_equal(gnss_history_count(&history), count - drained);
+
+	for (size_t i = 0; i < drained; i++) {
+		zassert_mem_equal(&fixes[i], &pushed[pushed_count - count + i], sizeof(fixes[i]));
+	}
+
+	return drained;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(history_buf, 0, sizeof(history_buf));
+	pushed_count = 0;
+	random_state = 1;
+	history_init(sizeof(history_buf));
+}
+
+ZTEST(lx6_history, test_init_invalid)
+{
+	struct gnss_history_config config = {
+		.buf = NULL,
+		.buf_size = sizeof(history_buf),
+	};
+
+	zassert_equal(gnss_history_init(&history, &config), -EINVAL);
+
+	config.buf = history_buf;
+	config.buf_size = HISTORY_BUF_SIZE_MIN - 1;
+	zassert_equal(gnss_history_init(&history, &config), -EINVAL);
+
+	config.buf_size = HISTORY_BUF_SIZE_MIN;
+	zassert_ok(gnss_history_init(&history, &config));
+	zassert_equal(gnss_history_count(&history), 0);
+}
+
+ZTEST(lx6_history, test_round_trip_across_wraps)
+{
+	/* Records of a few to 60 bytes wrap around the ring hundreds of times */
+	history_init(128);
+
+	for (size_t i = 0; i < HISTORY_PUSHES_MAX; i++) {
+		push_next();
+		assert_stored();
+		zassert_true(gnss_history_count(&history) >= MIN(i + 1, 2));
+	}
+
+	zassert_true(gnss_history_count(&history) < HISTORY_PUSHES_MAX);
+}
+
+ZTEST(lx6_history, test_round_trip_largest_records)
+{
+	static const struct gnss_history_fix fixes[] = {
+		{0},
+		{
+			.timestamp_ms = BIT64(63),
+			.latitude = INT64_MIN,
+			.longitude = INT64_MIN,
+			.altitude = INT32_MIN,
+			.speed = UINT32_MAX,
+			.bearing = UINT32_MAX,
+		},
+	};
+
+	/* Each record fills most of the ring, leaving the key frame and the newest fix */
+	history_init(HISTORY_BUF_SIZE_MIN);
+
+	for (size_t i = 0; i < 100; i++) {
+		push(&fixes[i % ARRAY_SIZE(fixes)]);
+		assert_stored();
+		zassert_equal(gnss_history_count(&history), MIN(i + 1, 2));
+	}
+}
+
+ZTEST(lx6_history, test_key_frame)
+{
+	struct gnss_history_fix fix = {
+		.timestamp_ms = 1000,
+		.latitude = 48117300000,
+		.longitude = 11516666666,
+	};
+
+	push(&fix);
+	push_next();
+	push_next();
+	assert_stored();
+
+	/* The next fix becomes the key frame as the oldest one is drained */
+	zassert_equal(drain(1), 1);
+	assert_stored();
+	zassert_equal(drain(1), 1);
+	assert_stored();
+	zassert_equal(gnss_history_count(&history), 1);
+
+	/* The key frame alone is stored, the ring being empty */
+	zassert_equal(drain(2), 1);
+	zassert_equal(gnss_history_count(&history), 0);
+	assert_stored();
+	zassert_equal(drain(2), 0);
+
+	/* A new key frame unrelated to the drained fixes */
+	fix.timestamp_ms = 5;
+	fix.latitude = -1;
+	fix.longitude = INT64_MIN;
+	push(&fix);
+	push_next();
+	assert_stored();
+	zassert_equal(gnss_history_count(&history), 2);
+}
+
+ZTEST(lx6_history, test_interleaved_push_and_drain)
+{
+	history_init(96);
+
+	while (pushed_count < (HISTORY_PUSHES_MAX - 3)) {
+		for (uint32_t i = random_next() % 4; i > 0; i--) {
+			push_next();
+		}
+
+		assert_stored();
+		(void)drain(random_next() % 3);
+		assert_stored();
+	}
+}
+
+ZTEST(lx6_history, test_drain_order)
+{
+	for (size_t i = 0; i < 10; i++) {
+		push_next();
+	}
+
+	zassert_equal(drain(3), 3);
+	zassert_equal(drain(3), 3);
+	zassert_equal(drain(3), 3);
+	zassert_equal(drain(3), 1);
+	zassert_equal(drain(3), 0);
+}
+
+ZTEST(lx6_history, test_foreach_order)
+{
+	struct visit_context context = {
+		.stop_after = 4,
+		.equal = true,
+	};
+
+	for (size_t i = 0; i < 10; i++) {
+		push_next();
+	}
+
+	/* Visiting stops early and leaves the fixes in place */
+	zassert_equal(gnss_history_foreach(&history, visit, &context), 4);
+	zassert_true(context.equal);
+	zassert_equal(gnss_history_count(&history), 10);
+	assert_stored();
+
+	zassert_equal(drain(6), 6);
+	assert_stored();
+	zassert_equal(gnss_history_count(&history), 4);
+}
+
+ZTEST(lx6_history, test_push_data)
+{
+	struct gnss_history_fix fix;
+	struct gnss_data data = {
+		.nav_data = {
+			.latitude = 48117300000,
+			.longitude = 11516666666,
+			.altitude = 545400,
+			.speed = 11523,
+			.bearing = 84400,
+		},
+		.info = {
+			.fix_status = GNSS_FIX_STATUS_GNSS_FIX,
+		},
+		.utc = {
+			.hour = 12,
+			.minute = 35,
+			.millisecond = 19500,
+		},
+	};
+
+	/* Time since midnight until the date is known */
+	gnss_history_push_data(&history, &data);
+	zassert_equal(gnss_history_drain(&history, &fix, 1), 1);
+	zassert_equal(fix.timestamp_ms, (12 * 3600000) + (35 * 60000) + 19500);
+	zassert_equal(fix.latitude, 48117300000);
+	zassert_equal(fix.longitude, 11516666666);
+	zassert_equal(fix.altitude, 545400);
+	zassert_equal(fix.speed, 11523);
+	zassert_equal(fix.bearing, 84400);
+
+	/* 8826 days from 2000-01-01 to 2024-03-01 */
+	data.utc.century_year = 24;
+	data.utc.month = 3;
+	data.utc.month_day = 1;
+	gnss_history_push_data(&history, &data);
+	zassert_equal(gnss_history_drain(&history, &fix, 1), 1);
+	zassert_equal(fix.timestamp_ms,
+		      (8826ULL * 86400000) + (12 * 3600000) + (35 * 60000) + 19500);
+
+	/* Loss of fix is not stored */
+	data.info.fix_status = GNSS_FIX_STATUS_NO_FIX;
+	gnss_history_push_data(&history, &data);
+	zassert_equal(gnss_history_count(&history), 0);
+}
+
+ZTEST_SUITE(lx6_history, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gnss_nmea0183_match.h"
+
+#define DISPATCH_ARGV_SIZE (24)
+
+/*
+ * Fields following the message id of every sentence type, checksums are
+ * validated before dispatch and are thus not checked by the handlers.
+ */
+static char *gga_fields[] = {"123519", "4807.038", "N", "01131.000", "E", "1", "08", "0.9",
+			     "545.4",  "M",        "46.9", "M",      "",  "", "47"};
+static char *rmc_fields[] = {"123519", "A",     "4807.038", "N",      "01131.000", "E", "022.4",
+			     "084.4",  "230324", "003.1",   "W",      "A",         "6A"};
+static char *gll_fields[] = {"4916.45", "N", "12311.12", "W", "225444", "A", "A", "1D"};
+static char *vtg_fields[] = {"054.7", "T", "034.4", "M", "005.5", "N", "010.2", "K", "A", "48"};
+static char *zda_fields[] = {"201530.00", "04", "07", "2024", "00", "00", "60"};
+static char *gst_fields[] = {"024603.00", "3.2", "6.6", "4.7", "47.3", "5.8", "5.6", "22.0", "6C"};
+static char *gsv_fields[] = {"3",  "1",  "11",  "03", "03", "111", "00", "04", "15", "270",
+			     "00", "06", "01",  "010", "00", "13",  "06", "292", "00", "74"};
+static char *gsa_fields[] = {"A", "3", "04", "05", "",    "09",  "12",  "", "", "24",
+			     "",  "",  "",   "",   "2.5", "1.3", "2.1", "39"};
+
+struct dispatch_case {
+	const char *type;
+	char **fields;
+	uint16_t fields_size;
+	/* Sentence marked as received in the epoch, 0 for GSV and GSA */
+	uint8_t sentence;
+	bool enabled;
+};
+
+static const struct dispatch_case dispatch_cases[] = {
+	{"GGA", gga_fields, ARRAY_SIZE(gga_fields), LX6_NMEA0183_MATCH_SENTENCE_GGA,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA)},
+	{"RMC", rmc_fields, ARRAY_SIZE(rmc_fields), LX6_NMEA0183_MATCH_SENTENCE_RMC,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_RMC)},
+	{"GLL", gll_fields, ARRAY_SIZE(gll_fields), LX6_NMEA0183_MATCH_SENTENCE_GLL,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GLL)},
+	{"VTG", vtg_fields, ARRAY_SIZE(vtg_fields), LX6_NMEA0183_MATCH_SENTENCE_VTG,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_VTG)},
+	{"ZDA", zda_fields, ARRAY_SIZE(zda_fields), LX6_NMEA0183_MATCH_SENTENCE_ZDA,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_ZDA)},
+	{"GST", gst_fields, ARRAY_SIZE(gst_fields), LX6_NMEA0183_MATCH_SENTENCE_GST,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GST)},
+	{"GSV", gsv_fields, ARRAY_SIZE(gsv_fields), 0,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GSV)},
+	{"GSA", gsa_fields, ARRAY_SIZE(gsa_fields), 0,
+	 IS_ENABLED(CONFIG_GNSS_QUECTEL_LX6_NMEA_GSA)},
+};
+
+/* Talkers of the systems supported by the receiver, and of combined solutions */
+static const char *const dispatch_talkers[] = {"GP", "GL", "GA", "GB", "GQ", "GN"};
+
+static struct gnss_satellite satellites[8];
+static struct lx6_nmea0183_match_data match;
+
+static const struct lx6_nmea0183_match_config match_config = {
+	.satellites = satellites,
+	.satellites_size = ARRAY_SIZE(satellites),
+	/* Epochs are never complete, keeping what was dispatched in the open epoch */
+	.epoch_required = LX6_NMEA0183_MATCH_SENTENCE_ALL,
+	.epoch_policy = LX6_NMEA0183_MATCH_EPOCH_DROP,
+	.epoch_timeout = K_SECONDS(10),
+};
+
+static void match_reset(void)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_delayable_sync(&match.epoch.timeout_work, &sync);
+	(void)k_work_cancel_delayable_sync(&match.sky.timeout_work, &sync);
+	zassert_ok(lx6_nmea0183_match_init(&match, &match_config));
+}
+
+static void dispatch(const char *talker, const char *type, char **fields, uint16_t fields_size)
+{
+	char message_id[8];
+	char *argv[DISPATCH_ARGV_SIZE];
+
+	zassert_true(fields_size < ARRAY_SIZE(argv));
+
+	snprintf(message_id, sizeof(message_id), "$%s%s", talker, type);
+	argv[0] = message_id;
+	memcpy(&argv[1], fields, fields_size * sizeof(fields[0]));
+	lx6_nmea0183_match_dispatch(&match, argv, fields_size + 1);
+}
+
+/* Whether the handler of the sentence type of a case has been run */
+static bool dispatched(const struct dispatch_case *dispatch_case)
+{
+	struct lx6_nmea0183_dop dop;
+
+	if (dispatch_case->sentence != 0) {
+		return match.epoch.received == dispatch_case->sentence;
+	}
+
+	if (strcmp(dispatch_case->type, "GSV") == 0) {
+		return match.sky.started != 0;
+	}
+
+	return lx6_nmea0183_match_get_dop(&match, &dop) == 0;
+}
+
+static bool dispatched_any(void)
+{
+	struct lx6_nmea0183_dop dop;
+
+	return match.epoch.open || (match.epoch.received != 0) || (match.sky.started != 0) ||
+	       (lx6_nmea0183_match_get_dop(&match, &dop) == 0);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	match_reset();
+}
+
+ZTEST(lx6_match_dispatch, test_key)
+{
+	uint32_t keys[ARRAY_SIZE(dispatch_talkers) * ARRAY_SIZE(dispatch_cases)];
+	char message_id[8];
+	size_t size = 0;
+
+	/* Every talker and sentence type combination has a key of its own */
+	ARRAY_FOR_EACH(dispatch_talkers, i) {
+		ARRAY_FOR_EACH_PTR(dispatch_cases, dispatch_case) {
+			snprintf(message_id, sizeof(message_id), "$%s%s", dispatch_talkers[i],
+				 dispatch_case->type);
+			keys[size] = lx6_nmea0183_match_key(message_id);
+			zassert_not_equal(keys[size], 0, "%s", message_id);
+
+			for (size_t j = 0; j < size; j++) {
+				zassert_not_equal(keys[j], keys[size], "%s", message_id);
+			}
+
+			size++;
+		}
+	}
+
+	zassert_equal(lx6_nmea0183_match_key("$GPGGA,"), lx6_nmea0183_match_key("$GPGGA"));
+	zassert_equal(lx6_nmea0183_match_key("GPGGA"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$GPGG"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$GPGGAA"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$GPGGA*"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$gpgga"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$GP1GA"), 0);
+	zassert_equal(lx6_nmea0183_match_key("$"), 0);
+	zassert_equal(lx6_nmea0183_match_key(""), 0);
+}
+
+ZTEST(lx6_match_dispatch, test_talkers_and_types)
+{
+	bool expected;
+
+	ARRAY_FOR_EACH(dispatch_talkers, i) {
+		ARRAY_FOR_EACH_PTR(dispatch_cases, dispatch_case) {
+			match_reset();
+			dispatch(dispatch_talkers[i], dispatch_case->type, dispatch_case->fields,
+				 dispatch_case->fields_size);
+
+			/* Satellites in view are reported per system, never combined */
+			expected = dispatch_case->enabled &&
+				   !((strcmp(dispatch_case->type, "GSV") == 0) &&
+				     (strcmp(dispatch_talkers[i], "GN") == 0));
+
+			zassert_equal(dispatched(dispatch_case), expected, "$%s%s",
+				      dispatch_talkers[i], dispatch_case->type);
+			zassert_equal(dispatched_any(), expected, "$%s%s", dispatch_talkers[i],
+				      dispatch_case->type);
+		}
+	}
+}
+
+ZTEST(lx6_match_dispatch, test_unknown_types)
+{
+	char type[4] = {0};
+	bool known;
+
+	/* Sentence types sharing a slot of the dispatch table must not be mistaken for another */
+	for (char a = 'A'; a <= 'Z'; a++) {
+		for (char b = 'A'; b <= 'Z'; b++) {
+			for (char c = 'A'; c <= 'Z'; c++) {
+				type[0] = a;
+				type[1] = b;
+				type[2] = c;
+
+				known = false;
+				ARRAY_FOR_EACH_PTR(dispatch_cases, dispatch_case) {
+					known = known || (strcmp(dispatch_case->type, type) == 0);
+				}
+
+				if (known) {
+					continue;
+				}
+
+				ARRAY_FOR_EACH_PTR(dispatch_cases, dispatch_case) {
+					dispatch("GP", type, dispatch_case->fields,
+						 dispatch_case->fields_size);
+					zassert_false(dispatched_any(), "$GP%s", type);
+				}
+			}
+		}
+	}
+}
+
+ZTEST(lx6_match_dispatch, test_invalid_message_ids)
+{
+	static const char *const message_ids[] = {"GPGGA", "$GPGG", "$GPGGAA", "$gpgga", "$GP1GA",
+						  "$", ""};
+	char *argv[DISPATCH_ARGV_SIZE];
+
+	ARRAY_FOR_EACH(message_ids, i) {
+		argv[0] = (char *)message_ids[i];
+		memcpy(&argv[1], gga_fields, sizeof(gga_fields));
+		lx6_nmea0183_match_dispatch(&match, argv, ARRAY_SIZE(gga_fields) + 1);
+		zassert_false(dispatched_any(), "%s", message_ids[i]);
+	}
+
+	lx6_nmea0183_match_dispatch(&match, argv, 0);
+	zassert_false(dispatched_any());
+}
+
+ZTEST(lx6_match_dispatch, test_empty_utc_ignored)
+{
+	char *fields[ARRAY_SIZE(gst_fields)];
+
+	/* Sentence output before the receiver knows the time does not open an epoch */
+	memcpy(fields, gst_fields, sizeof(gst_fields));
+	fields[0] = "";
+	dispatch("GP", "GST", fields, ARRAY_SIZE(fields));
+	zassert_false(dispatched_any());
+}
+
+ZTEST(lx6_match_dispatch, test_used_satellites_per_epoch)
+{
+	static const struct gnss_satellite used = {.prn = 4, .system = GNSS_SYSTEM_GPS};
+	char *fields[ARRAY_SIZE(gst_fields)];
+
+	memcpy(fields, gst_fields, sizeof(gst_fields));
+	dispatch("GP", "GST", fields, ARRAY_SIZE(fields));
+	dispatch("GP", "GSA", gsa_fields, ARRAY_SIZE(gsa_fields));
+	zassert_true(lx6_nmea0183_match_is_used(&match, &used));
+
+	/* Satellites are no longer reported used once the next epoch begins */
+	fields[0] = "024604.00";
+	dispatch("GP", "GST", fields, ARRAY_SIZE(fields));
+	zassert_false(lx6_nmea0183_match_is_used(&match, &used));
+}
+
+ZTEST_SUITE(lx6_match_dispatch, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "gnss_nmea0183_match.h"
+
+/* Horizontal standard deviation gate in millimeters */
+#define GATE_MM (2000)
+
+/* Epochs are made of the sentence carrying the fix status and of GST */
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA
+#define GATE_SENTENCES (LX6_NMEA0183_MATCH_SENTENCE_GGA | LX6_NMEA0183_MATCH_SENTENCE_GST)
+#else
+#define GATE_SENTENCES (LX6_NMEA0183_MATCH_SENTENCE_GLL | LX6_NMEA0183_MATCH_SENTENCE_GST)
+#endif
+
+static struct gnss_satellite satellites[8];
+static struct lx6_nmea0183_match_data match;
+
+static const struct lx6_nmea0183_match_config match_config = {
+	.satellites = satellites,
+	.satellites_size = ARRAY_SIZE(satellites),
+	.epoch_required = GATE_SENTENCES,
+	.epoch_policy = LX6_NMEA0183_MATCH_EPOCH_DROP,
+	.epoch_timeout = K_SECONDS(10),
+	.accuracy_gate = GATE_MM,
+};
+
+static void dispatch_fix(char *utc, bool fix)
+{
+#if CONFIG_GNSS_QUECTEL_LX6_NMEA_GGA
+	char *fix_argv[] = {"$GPGGA", utc, "4807.038", "N", "01131.000", "E", "1", "08",
+			    "0.9", "545.4", "M", "46.9", "M", "", "", "47"};
+	char *no_fix_argv[] = {"$GPGGA", utc, "", "", "", "", "0", "00", "99.99", "", "", "", "",
+			       "", "", "66"};
+#else
+	char *fix_argv[] = {"$GPGLL", "4807.038", "N", "01131.000", "E", utc, "A", "A", "1D"};
+	char *no_fix_argv[] = {"$GPGLL", "", "", "", "", utc, "V", "N", "64"};
+#endif
+
+	if (fix) {
+		lx6_nmea0183_match_dispatch(&match, fix_argv, ARRAY_SIZE(fix_argv));
+	} else {
+		lx6_nmea0183_match_dispatch(&match, no_fix_argv, ARRAY_SIZE(no_fix_argv));
+	}
+}
+
+/* Statistics are empty without fix */
+static void dispatch_gst(char *utc, char *latitude_stddev, char *longitude_stddev)
+{
+	char *altitude_stddev = (latitude_stddev[0] != '\0') ? "22.0" : "";
+	char *argv[] = {"$GPGST",        utc,          "3.2", "6.6", "4.7", "47.3",
+			latitude_stddev, longitude_stddev, altitude_stddev, "6C"};
+
+	lx6_nmea0183_match_dispatch(&match, argv, ARRAY_SIZE(argv));
+}
+
+static void assert_epochs(uint32_t complete, uint32_t gated)
+{
+	struct lx6_nmea0183_match_epoch_stats stats;
+
+	zassert_ok(lx6_nmea0183_match_get_epoch_stats(&match, &stats));
+	zassert_equal(stats.complete, complete);
+	zassert_equal(stats.gated, gated);
+}
+
+static void assert_latest(enum gnss_fix_status fix_status)
+{
+	struct gnss_data latest;
+
+	zassert_ok(lx6_nmea0183_match_get_latest(&match, &latest));
+	zassert_equal(latest.info.fix_status, fix_status);
+}
+
+static void before(void *fixture)
+{
+	struct k_work_sync sync;
+
+	ARG_UNUSED(fixture);
+
+	(void)k_work_cancel_delayable_sync(&match.epoch.timeout_work, &sync);
+	(void)k_work_cancel_delayable_sync(&match.sky.timeout_work, &sync);
+	zassert_ok(lx6_nmea0183_match_init(&match, &match_config));
+}
+
+ZTEST(lx6_match_gate, test_accurate_fix_published)
+{
+	/* Horizontal standard deviation of 1.3 m */
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "1.2", "0.5");
+
+	assert_epochs(1, 0);
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+}
+
+ZTEST(lx6_match_gate, test_inaccurate_fix_gated)
+{
+	struct gnss_data latest;
+
+	/* Horizontal standard deviation of 2.05 m, each below the gate */
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "1.5", "1.4");
+
+	assert_epochs(1, 1);
+	zassert_equal(lx6_nmea0183_match_get_latest(&match, &latest), -ENODATA);
+}
+
+ZTEST(lx6_match_gate, test_fix_without_statistics_gated)
+{
+	struct gnss_data latest;
+
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "", "");
+
+	assert_epochs(1, 1);
+	zassert_equal(lx6_nmea0183_match_get_latest(&match, &latest), -ENODATA);
+}
+
+ZTEST(lx6_match_gate, test_loss_of_fix_published)
+{
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "1.2", "0.5");
+	assert_epochs(1, 0);
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+
+	/* Loss of fix is published even though it comes without statistics */
+	dispatch_fix("123520", false);
+	dispatch_gst("123520", "", "");
+	assert_epochs(2, 0);
+	assert_latest(GNSS_FIX_STATUS_NO_FIX);
+}
+
+ZTEST(lx6_match_gate, test_loss_of_fix_published_after_gated_fix)
+{
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "1.2", "0.5");
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+
+	dispatch_fix("123520", true);
+	dispatch_gst("123520", "25.0", "30.0");
+	assert_epochs(2, 1);
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+
+	/* The last published fix must not be left standing once the fix is lost */
+	dispatch_fix("123521", false);
+	dispatch_gst("123521", "", "");
+	assert_epochs(3, 1);
+	assert_latest(GNSS_FIX_STATUS_NO_FIX);
+}
+
+ZTEST(lx6_match_gate, test_gate_disabled)
+{
+	lx6_nmea0183_match_set_accuracy_gate(&match, 0);
+
+	dispatch_fix("123519", true);
+	dispatch_gst("123519", "25.0", "30.0");
+	assert_epochs(1, 0);
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+
+	dispatch_fix("123520", true);
+	dispatch_gst("123520", "", "");
+	assert_epochs(2, 0);
+	assert_latest(GNSS_FIX_STATUS_GNSS_FIX);
+}
+
+ZTEST_SUITE(lx6_match_gate, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gnss.h>
+#include <zephyr/ztest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gnss_nmea0183_match.h"
+
+static struct gnss_satellite satellites[8];
+static struct lx6_nmea0183_match_data match;
+
+/* Epochs are closed by GST, which is output in both profiles */
+static const struct lx6_nmea0183_match_config match_config = {
+	.satellites = satellites,
+	.satellites_size = ARRAY_SIZE(satellites),
+	.epoch_required = LX6_NMEA0183_MATCH_SENTENCE_GST,
+	.epoch_policy = LX6_NMEA0183_MATCH_EPOCH_DROP,
+	.epoch_timeout = K_SECONDS(10),
+};
+
+static uint16_t published;
+static uint16_t published_size;
+static struct gnss_satellite published_satellites[ARRAY_SIZE(satellites)];
+
+static void sky_callback(const struct device *dev, const struct gnss_satellite *satellites,
+			 uint16_t size)
+{
+	published++;
+	published_size = MIN(size, ARRAY_SIZE(published_satellites));
+	memcpy(published_satellites, satellites, published_size * sizeof(satellites[0]));
+}
+
+GNSS_SATELLITES_CALLBACK_DEFINE(NULL, sky_callback);
+
+static void dispatch_gst(char *utc)
+{
+	char *argv[] = {"$GPGST", utc, "3.2", "6.6", "4.7", "47.3", "5.8", "5.6", "22.0", "6C"};
+
+	lx6_nmea0183_match_dispatch(&match, argv, ARRAY_SIZE(argv));
+}
+
+/* Message of a GSV sequence, reporting 4 satellites from the first PRN on */
+static void dispatch_gsv(const char *talker, char *number_of_messages, char *message_number,
+			 uint16_t prn)
+{
+	char message_id[8];
+	char prns[4][4];
+	char *argv[] = {message_id, number_of_messages, message_number, "12",
+			prns[0],    "03",               "111",          "30",
+			prns[1],    "15",               "270",          "30",
+			prns[2],    "01",               "010",          "30",
+			prns[3],    "06",               "292",          "30",
+			"74"};
+
+	snprintf(message_id, sizeof(message_id), "$%sGSV", talker);
+	for (size_t i = 0; i < ARRAY_SIZE(prns); i++) {
+		snprintf(prns[i], sizeof(prns[i]), "%u", prn + i);
+	}
+
+	lx6_nmea0183_match_dispatch(&match, argv, ARRAY_SIZE(argv));
+}
+
+static void before(void *fixture)
+{
+	struct k_work_sync sync;
+
+	ARG_UNUSED(fixture);
+
+	(void)k_work_cancel_delayable_sync(&match.epoch.timeout_work, &sync);
+	(void)k_work_cancel_delayable_sync(&match.sky.timeout_work, &sync);
+	zassert_ok(lx6_nmea0183_match_init(&match, &match_config));
+	published = 0;
+	published_size = 0;
+}
+
+ZTEST(lx6_match_sky, test_incomplete_sequence_discarded)
+{
+	dispatch_gst("123519");
+	dispatch_gsv("GP", "1", "1", 1);
+
+	/* Second message of GLONASS does not fit, so its first one is left out too */
+	dispatch_gsv("GL", "2", "1", 65);
+	dispatch_gsv("GL", "2", "2", 69);
+
+	dispatch_gst("123520");
+	zassert_equal(published, 1);
+	zassert_equal(published_size, 4);
+
+	for (uint16_t i = 0; i < published_size; i++) {
+		zassert_equal(published_satellites[i].system, GNSS_SYSTEM_GPS);
+	}
+}
+
+ZTEST(lx6_match_sky, test_published_once_per_epoch)
+{
+	/* Systems of the first sky view are only known once it has been flushed */
+	dispatch_gst("123519");
+	dispatch_gsv("GP", "1", "1", 1);
+	dispatch_gst("123520");
+	zassert_equal(published, 1);
+
+	/* Sky view is published as soon as the expected systems are received */
+	dispatch_gsv("GP", "1", "1", 1);
+	zassert_equal(published, 2);
+
+	/* A system received afterwards does not publish the epoch again */
+	dispatch_gsv("GL", "1", "1", 65);
+	dispatch_gst("123521");
+	zassert_equal(published, 2);
+}
+
+ZTEST_SUITE(lx6_match_sky, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include <string.h>
+
+#include "gnss_nmea0183.h"
+
+/* Index of the number of satellites, argv[0] being the message id */
+#define GGA_SATELLITES (7)
+
+static const char *gga_argv[] = {
+	"$GPGGA", "123519", "4807.038", "N", "01131.000", "E", "1", "08", "0.9", "545.4", "M",
+	"46.9", "M", "", "", "47",
+};
+
+/* Index of the standard deviations of latitude, longitude and altitude */
+#define GST_LATITUDE_STDDEV  (6)
+#define GST_LONGITUDE_STDDEV (7)
+#define GST_ALTITUDE_STDDEV  (8)
+
+static const char *gst_argv[] = {
+	"$GPGST", "024603.00", "3.2", "6.6", "4.7", "47.3", "5.8", "5.6", "22.0", "6C",
+};
+
+static struct gnss_data data;
+static struct lx6_nmea0183_gst gst;
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&data, 0, sizeof(data));
+	memset(&gst, 0, sizeof(gst));
+	gga_argv[GGA_SATELLITES] = "08";
+	gst_argv[GST_LATITUDE_STDDEV] = "5.8";
+	gst_argv[GST_LONGITUDE_STDDEV] = "5.6";
+	gst_argv[GST_ALTITUDE_STDDEV] = "22.0";
+}
+
+ZTEST(lx6_nmea0183, test_gga)
+{
+	zassert_ok(lx6_nmea0183_parse_gga(gga_argv, ARRAY_SIZE(gga_argv), &data));
+	zassert_equal(data.info.fix_status, GNSS_FIX_STATUS_GNSS_FIX);
+	zassert_equal(data.info.satellites_cnt, 8);
+	zassert_equal(data.info.hdop, 900);
+	zassert_equal(data.nav_data.altitude, 545400);
+}
+
+ZTEST(lx6_nmea0183, test_gga_empty_satellites)
+{
+	/* An empty number of satellites has always been accepted as none */
+	data.info.satellites_cnt = 8;
+	gga_argv[GGA_SATELLITES] = "";
+
+	zassert_ok(lx6_nmea0183_parse_gga(gga_argv, ARRAY_SIZE(gga_argv), &data));
+	zassert_equal(data.info.satellites_cnt, 0);
+}
+
+ZTEST(lx6_nmea0183, test_gga_invalid_satellites)
+{
+	gga_argv[GGA_SATELLITES] = "8a";
+	zassert_equal(lx6_nmea0183_parse_gga(gga_argv, ARRAY_SIZE(gga_argv), &data), -EINVAL);
+
+	gga_argv[GGA_SATELLITES] = "-1";
+	zassert_equal(lx6_nmea0183_parse_gga(gga_argv, ARRAY_SIZE(gga_argv), &data), -EINVAL);
+
+	gga_argv[GGA_SATELLITES] = "65536";
+	zassert_equal(lx6_nmea0183_parse_gga(gga_argv, ARRAY_SIZE(gga_argv), &data), -EINVAL);
+}
+
+ZTEST(lx6_nmea0183, test_gst)
+{
+	zassert_ok(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst));
+	zassert_equal(gst.latitude_stddev, 5800);
+	zassert_equal(gst.longitude_stddev, 5600);
+	zassert_equal(gst.altitude_stddev, 22000);
+
+	gst_argv[GST_LATITUDE_STDDEV] = "0";
+	gst_argv[GST_LONGITUDE_STDDEV] = "0.001";
+	gst_argv[GST_ALTITUDE_STDDEV] = "99999.999";
+	zassert_ok(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst));
+	zassert_equal(gst.latitude_stddev, 0);
+	zassert_equal(gst.longitude_stddev, 1);
+	zassert_equal(gst.altitude_stddev, 99999999);
+}
+
+ZTEST(lx6_nmea0183, test_gst_empty_fields)
+{
+	/* Statistics are empty without fix, each of them is required */
+	gst_argv[GST_LATITUDE_STDDEV] = "";
+	zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst), -ENODATA);
+
+	gst_argv[GST_LATITUDE_STDDEV] = "5.8";
+	gst_argv[GST_LONGITUDE_STDDEV] = "";
+	zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst), -ENODATA);
+
+	gst_argv[GST_LONGITUDE_STDDEV] = "5.6";
+	gst_argv[GST_ALTITUDE_STDDEV] = "";
+	zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst), -ENODATA);
+
+	gst_argv[GST_LATITUDE_STDDEV] = "";
+	gst_argv[GST_LONGITUDE_STDDEV] = "";
+	zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst), -ENODATA);
+}
+
+ZTEST(lx6_nmea0183, test_gst_invalid_fields)
+{
+	static const char *const invalid[] = {"5.8a", "-0.1", "100000.000", "..", "--", "0x10"};
+
+	ARRAY_FOR_EACH(invalid, i) {
+		gst_argv[GST_LATITUDE_STDDEV] = invalid[i];
+		zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst),
+			      -EINVAL, "%s", invalid[i]);
+		gst_argv[GST_LATITUDE_STDDEV] = "5.8";
+
+		gst_argv[GST_LONGITUDE_STDDEV] = invalid[i];
+		zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst),
+			      -EINVAL, "%s", invalid[i]);
+		gst_argv[GST_LONGITUDE_STDDEV] = "5.6";
+
+		gst_argv[GST_ALTITUDE_STDDEV] = invalid[i];
+		zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv), &gst),
+			      -EINVAL, "%s", invalid[i]);
+		gst_argv[GST_ALTITUDE_STDDEV] = "22.0";
+	}
+
+	/* Truncated sentence */
+	zassert_equal(lx6_nmea0183_parse_gst(gst_argv, ARRAY_SIZE(gst_argv) - 1, &gst), -EINVAL);
+}
+
+ZTEST_SUITE(lx6_nmea0183, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "gnss_nmea0183.h"
+#include "gnss_parse.h"
+#include "lx6_bench.h"
+#include "reference.h"
+
+#define BENCH_ROUNDS (20000U)
+
+typedef int (*bench_parse_fn)(const char *str, int64_t *value);
+
+struct bench_case {
+	const char *name;
+	bench_parse_fn reference;
+	bench_parse_fn current;
+	const char *const *fields;
+	size_t count;
+};
+
+/* Fields as output in GGA and RMC sentences */
+static const char *const bench_decimals[] = {"1.02", "545.4", "46.9", "022.4", "0.9", "0.004"};
+static const char *const bench_coordinates[] = {"4807.038", "01131.000", "4807.03812",
+						"01131.00045"};
+static const char *const bench_times[] = {"123519", "123519.000", "235959.999"};
+
+/* Fields as output in GSV sentences, and checksums */
+static const char *const bench_integers[] = {"03", "15", "270", "42", "12", "359", "7", "99"};
+static const char *const bench_checksums[] = {"47", "7A", "0F", "FF"};
+
+static volatile int64_t bench_sink;
+
+static int reference_micro(const char *str, int64_t *value)
+{
+	return reference_dec_to_micro(str, (uint64_t *)value);
+}
+
+static int current_micro(const char *str, int64_t *value)
+{
+	return lx6_parse_dec_to_micro(str, (uint64_t *)value);
+}
+
+static int reference_hhmmss(const char *str, int64_t *value)
+{
+	struct gnss_time utc;
+	int ret;
+
+	ret = reference_parse_hhmmss(str, &utc);
+	*value = utc.millisecond;
+	return ret;
+}
+
+static int current_hhmmss(const char *str, int64_t *value)
+{
+	struct gnss_time utc;
+	int ret;
+
+	ret = lx6_nmea0183_parse_hhmmss(str, &utc);
+	*value = utc.millisecond;
+	return ret;
+}
+
+/* The previous callers validated the bounds of the value themselves */
+static int reference_integer(const char *str, int64_t *value)
+{
+	int32_t i32;
+	int ret;
+
+	ret = reference_atoi(str, 10, &i32);
+	if ((ret < 0) || (i32 < 0) || (i32 > 359)) {
+		return -EINVAL;
+	}
+
+	*value = i32;
+	return 0;
+}
+
+static int current_integer(const char *str, int64_t *value)
+{
+	uint16_t u16;
+	int ret;
+
+	ret = lx6_parse_dec_to_u16(str, 0, 359, &u16);
+	*value = u16;
+	return ret;
+}
+
+static int reference_checksum(const char *str, int64_t *value)
+{
+	int32_t i32;
+	int ret;
+
+	ret = reference_atoi(str, 16, &i32);
+	if ((ret < 0) || (i32 < 0) || (i32 > UINT8_MAX)) {
+		return -EINVAL;
+	}
+
+	*value = i32;
+	return 0;
+}
+
+static int current_checksum(const char *str, int64_t *value)
+{
+	uint8_t u8;
+	int ret;
+
+	ret = lx6_parse_hex_to_u8(str, 0, UINT8_MAX, &u8);
+	*value = u8;
+	return ret;
+}
+
+static const struct bench_case bench_cases[] = {
+	{"dec_to_milli", reference_dec_to_milli, lx6_parse_dec_to_milli, bench_decimals,
+	 ARRAY_SIZE(bench_decimals)},
+	{"dec_to_micro", reference_micro, current_micro, bench_decimals,
+	 ARRAY_SIZE(bench_decimals)},
+	{"dec_to_nano", reference_dec_to_nano, lx6_parse_dec_to_nano, bench_decimals,
+	 ARRAY_SIZE(bench_decimals)},
+	{"knots_to_mms", reference_knots_to_mms, lx6_nmea0183_knots_to_mms, bench_decimals,
+	 ARRAY_SIZE(bench_decimals)},
+	{"ddmm_mmmm_to_ndeg", reference_ddmm_mmmm_to_ndeg, lx6_nmea0183_ddmm_mmmm_to_ndeg,
+	 bench_coordinates, ARRAY_SIZE(bench_coordinates)},
+	{"parse_hhmmss", reference_hhmmss, current_hhmmss, bench_times, ARRAY_SIZE(bench_times)},
+	{"dec_to_u16", reference_integer, current_integer, bench_integers,
+	 ARRAY_SIZE(bench_integers)},
+	{"hex_to_u8", reference_checksum, current_checksum, bench_checksums,
+	 ARRAY_SIZE(bench_checksums)},
+};
+
+/* Get the average time spent parsing a field, in picoseconds */
+static uint32_t bench_run(bench_parse_fn fn, const char *const *fields, size_t count)
+{
+	uint64_t start;
+	int64_t value;
+
+	start = lx6_bench_start();
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (size_t i = 0; i < count; i++) {
+			(void)fn(fields[i], &value);
+			bench_sink = value;
+		}
+	}
+
+	return (lx6_bench_elapsed_ns(start) * 1000U) / (BENCH_ROUNDS * count);
+}
+
+ZTEST(lx6_parse_benchmark, test_fields)
+{
+	uint32_t reference_ps;
+	uint32_t current_ps;
+
+	ARRAY_FOR_EACH_PTR(bench_cases, bench) {
+		reference_ps = bench_run(bench->reference, bench->fields, bench->count);
+		current_ps = bench_run(bench->current, bench->fields, bench->count);
+
+		TC_PRINT("%-18s %6u.%03u ns -> %6u.%03u ns per field\n", bench->name,
+			 reference_ps / 1000U, reference_ps % 1000U, current_ps / 1000U,
+			 current_ps % 1000U);
+	}
+}
+
+ZTEST_SUITE(lx6_parse_benchmark, lx6_bench_predicate, NULL, NULL, NULL, NULL);
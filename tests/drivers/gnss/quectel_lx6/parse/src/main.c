@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include <string.h>
+
+#include "gnss_nmea0183.h"
+#include "gnss_parse.h"
+#include "reference.h"
+
+/* Number of generated inputs compared against the previous implementation */
+#define SWEEP_COUNT (20000)
+
+/* Longest field of a NMEA0183 sentence, 82 characters at most */
+#define FIELD_SIZE_MAX (80)
+
+static const char *const decimals[] = {
+	"0",
+	"-0",
+	"1",
+	"-1",
+	"0.5",
+	"-0.5",
+	"5.",
+	".5",
+	"-.5",
+	"12.3456789",
+	"123456789",
+	"-123456789.987654321",
+	"999999999.999999999",
+	"1.0000000001",
+	"0.000000001",
+	"0.0000000009",
+	"-0.0000000009",
+	"00001.10000",
+	"1852.01",
+	"4807.038",
+	"59.9999",
+	"0.0000019",
+	"1.9999",
+	"-1.9999",
+	"",
+	"-",
+	".",
+	"-.",
+	"1.2.3",
+	"1a",
+	"a1",
+	"1-",
+	"--1",
+	"..1",
+};
+
+static const char *const coordinates[] = {
+	"4807.038",
+	"01131.000",
+	"0000.0000",
+	"9000.0000",
+	"18000.0000",
+	"5959.9999",
+	"0.5",
+	"5.5",
+	"59.99",
+	"4807.",
+	"4807.03800000000",
+	"123456789.0",
+	"999995959.9",
+	"4860.000",
+	"4807",
+	".5",
+	".",
+	"",
+	"-4807.038",
+	"4807.0-38",
+	"48a7.038",
+	"4807.038.1",
+};
+
+static uint32_t sweep_state;
+
+static uint32_t sweep_rand(uint32_t range)
+{
+	sweep_state = (sweep_state * 1103515245U) + 12345U;
+	return (sweep_state >> 16) % range;
+}
+
+static char *sweep_digits(char *pos, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++) {
+		*pos++ = '0' + sweep_rand(10);
+	}
+
+	return pos;
+}
+
+/*
+ * Build a random decimal within the range of the previous implementation, which
+ * overflowed beyond 9 integer digits.
+ */
+static void sweep_decimal(char *str, bool sign)
+{
+	char *pos = str;
+
+	if (sign && (sweep_rand(4) == 0)) {
+		*pos++ = '-';
+	}
+
+	pos = sweep_digits(pos, sweep_rand(10));
+
+	if (sweep_rand(4) != 0) {
+		*pos++ = '.';
+		pos = sweep_digits(pos, sweep_rand(13));
+	}
+
+	*pos = '\0';
+}
+
+static void sweep_coordinate(char *str)
+{
+	char *pos = str;
+
+	pos = sweep_digits(pos, 1 + sweep_rand(9));
+	*pos++ = '.';
+	pos = sweep_digits(pos, sweep_rand(11));
+	*pos = '\0';
+}
+
+static void assert_dec_bit_exact(const char *str)
+{
+	int64_t expected;
+	int64_t actual;
+	uint64_t expected_u64;
+	uint64_t actual_u64;
+	int ret;
+
+	ret = reference_dec_to_nano(str, &expected);
+	zassert_equal(lx6_parse_dec_to_nano(str, &actual), ret, "\"%s\"", str);
+	zassert_true((ret < 0) || (actual == expected), "\"%s\"", str);
+
+	ret = reference_dec_to_milli(str, &expected);
+	zassert_equal(lx6_parse_dec_to_milli(str, &actual), ret, "\"%s\"", str);
+	zassert_true((ret < 0) || (actual == expected), "\"%s\"", str);
+
+	/* Micro parts are unsigned, negative values were never defined */
+	if (str[0] == '-') {
+		return;
+	}
+
+	ret = reference_dec_to_micro(str, &expected_u64);
+	zassert_equal(lx6_parse_dec_to_micro(str, &actual_u64), ret, "\"%s\"", str);
+	zassert_true((ret < 0) || (actual_u64 == expected_u64), "\"%s\"", str);
+}
+
+static void assert_coordinate_bit_exact(const char *str)
+{
+	int64_t expected;
+	int64_t actual;
+	int ret;
+
+	ret = reference_ddmm_mmmm_to_ndeg(str, &expected);
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg(str, &actual), ret, "\"%s\"", str);
+	zassert_true((ret < 0) || (actual == expected), "\"%s\"", str);
+
+	ret = reference_knots_to_mms(str, &expected);
+	zassert_equal(lx6_nmea0183_knots_to_mms(str, &actual), ret, "\"%s\"", str);
+	zassert_true((ret < 0) || (actual == expected), "\"%s\"", str);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sweep_state = 1;
+}
+
+ZTEST(lx6_parse, test_dec_bit_exact)
+{
+	char str[FIELD_SIZE_MAX + 1];
+
+	ARRAY_FOR_EACH(decimals, i) {
+		assert_dec_bit_exact(decimals[i]);
+	}
+
+	for (uint32_t i = 0; i < SWEEP_COUNT; i++) {
+		sweep_decimal(str, true);
+		assert_dec_bit_exact(str);
+	}
+}
+
+ZTEST(lx6_parse, test_dec_truncated_decimals)
+{
+	int64_t i64;
+	uint64_t u64;
+
+	/* Decimals beyond the resolution are validated and truncated towards zero */
+	zassert_ok(lx6_parse_dec_to_milli("1.9999", &i64));
+	zassert_equal(i64, 1999);
+	zassert_ok(lx6_parse_dec_to_milli("-1.9999", &i64));
+	zassert_equal(i64, -1999);
+	zassert_ok(lx6_parse_dec_to_micro("0.0000019", &u64));
+	zassert_equal(u64, 1);
+	zassert_ok(lx6_parse_dec_to_nano("0.0000000019", &i64));
+	zassert_equal(i64, 1);
+	zassert_ok(lx6_parse_dec_to_nano("-0.0000000009", &i64));
+	zassert_equal(i64, 0);
+	zassert_equal(lx6_parse_dec_to_milli("1.999a", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_nano("0.0000000001.", &i64), -EINVAL);
+}
+
+ZTEST(lx6_parse, test_dec_lone_sign_and_point)
+{
+	int64_t i64;
+	uint64_t u64;
+
+	/* A lone sign or decimal point has no digits, which parses as zero */
+	i64 = 1;
+	zassert_ok(lx6_parse_dec_to_nano("-", &i64));
+	zassert_equal(i64, 0);
+	i64 = 1;
+	zassert_ok(lx6_parse_dec_to_nano(".", &i64));
+	zassert_equal(i64, 0);
+	i64 = 1;
+	zassert_ok(lx6_parse_dec_to_milli("-.", &i64));
+	zassert_equal(i64, 0);
+	u64 = 1;
+	zassert_ok(lx6_parse_dec_to_micro("", &u64));
+	zassert_equal(u64, 0);
+
+	zassert_equal(lx6_parse_dec_to_nano("--", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_nano("..", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_nano(".-", &i64), -EINVAL);
+}
+
+ZTEST(lx6_parse, test_dec_maximum_length)
+{
+	char str[FIELD_SIZE_MAX + 1];
+	int64_t i64;
+	uint64_t u64;
+
+	/* Decimals filling a whole field */
+	str[0] = '1';
+	str[1] = '.';
+	memset(&str[2], '9', FIELD_SIZE_MAX - 2);
+	str[FIELD_SIZE_MAX] = '\0';
+
+	zassert_ok(lx6_parse_dec_to_nano(str, &i64));
+	zassert_equal(i64, 1999999999LL);
+	zassert_ok(lx6_parse_dec_to_micro(str, &u64));
+	zassert_equal(u64, 1999999ULL);
+	zassert_ok(lx6_parse_dec_to_milli(str, &i64));
+	zassert_equal(i64, 1999LL);
+
+	/* Leading zeros filling a whole field */
+	memset(str, '0', FIELD_SIZE_MAX - 1);
+	str[FIELD_SIZE_MAX - 1] = '1';
+	str[FIELD_SIZE_MAX] = '\0';
+
+	zassert_ok(lx6_parse_dec_to_nano(str, &i64));
+	zassert_equal(i64, 1000000000LL);
+
+	/* Integer digits filling a whole field */
+	memset(str, '9', FIELD_SIZE_MAX);
+	str[FIELD_SIZE_MAX] = '\0';
+
+	zassert_equal(lx6_parse_dec_to_milli(str, &i64), -EINVAL);
+}
+
+ZTEST(lx6_parse, test_dec_range)
+{
+	int64_t i64;
+
+	/* Largest values representable at every resolution */
+	zassert_ok(lx6_parse_dec_to_nano("9223372036.854775807", &i64));
+	zassert_equal(i64, INT64_MAX);
+	zassert_ok(lx6_parse_dec_to_nano("-9223372036.854775807", &i64));
+	zassert_equal(i64, -INT64_MAX);
+	zassert_ok(lx6_parse_dec_to_milli("9223372036854775.807", &i64));
+	zassert_equal(i64, INT64_MAX);
+
+	/* One past them must be rejected rather than wrap around */
+	zassert_equal(lx6_parse_dec_to_nano("9223372036.854775808", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_nano("-9223372036.854775808", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_milli("9223372036854775.808", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_milli("9223372036854775808", &i64), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_nano("9223372037", &i64), -EINVAL);
+}
+
+ZTEST(lx6_parse, test_coordinate_bit_exact)
+{
+	char str[FIELD_SIZE_MAX + 1];
+
+	ARRAY_FOR_EACH(coordinates, i) {
+		assert_coordinate_bit_exact(coordinates[i]);
+	}
+
+	for (uint32_t i = 0; i < SWEEP_COUNT; i++) {
+		sweep_coordinate(str);
+		assert_coordinate_bit_exact(str);
+	}
+}
+
+ZTEST(lx6_parse, test_coordinate_boundaries)
+{
+	int64_t ndeg;
+
+	/* Minute digits always had truncated weights, 4807.038 is a nano degree short */
+	zassert_ok(lx6_nmea0183_ddmm_mmmm_to_ndeg("4807.038", &ndeg));
+	zassert_equal(ndeg, 48117299999LL);
+	zassert_ok(lx6_nmea0183_ddmm_mmmm_to_ndeg("18000.0000", &ndeg));
+	zassert_equal(ndeg, 180000000000LL);
+	zassert_ok(lx6_nmea0183_ddmm_mmmm_to_ndeg("999995959.9", &ndeg));
+
+	/* Minutes out of range, missing decimal and too many integer digits */
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg("4860.000", &ndeg), -EINVAL);
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg("4807", &ndeg), -EINVAL);
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg(".", &ndeg), -EINVAL);
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg("-", &ndeg), -EINVAL);
+	zassert_equal(lx6_nmea0183_ddmm_mmmm_to_ndeg("1234567890.0", &ndeg), -EINVAL);
+}
+
+ZTEST(lx6_parse, test_time_bit_exact)
+{
+	struct gnss_time expected;
+	struct gnss_time actual;
+	char str[FIELD_SIZE_MAX + 1];
+	char *pos;
+	int ret;
+
+	for (uint32_t i = 0; i < SWEEP_COUNT; i++) {
+		pos = sweep_digits(str, 6);
+		if (sweep_rand(2) != 0) {
+			*pos++ = '.';
+			pos = sweep_digits(pos, sweep_rand(4));
+		}
+
+		*pos = '\0';
+
+		memset(&expected, 0, sizeof(expected));
+		memset(&actual, 0, sizeof(actual));
+		ret = reference_parse_hhmmss(str, &expected);
+		zassert_equal(lx6_nmea0183_parse_hhmmss(str, &actual), ret, "\"%s\"", str);
+		zassert_true((ret < 0) || (memcmp(&actual, &expected, sizeof(actual)) == 0),
+			     "\"%s\"", str);
+
+		str[6] = '\0';
+		memset(&expected, 0, sizeof(expected));
+		memset(&actual, 0, sizeof(actual));
+		ret = reference_parse_ddmmyy(str, &expected);
+		zassert_equal(lx6_nmea0183_parse_ddmmyy(str, &actual), ret, "\"%s\"", str);
+		zassert_true((ret < 0) || (memcmp(&actual, &expected, sizeof(actual)) == 0),
+			     "\"%s\"", str);
+	}
+}
+
+ZTEST(lx6_parse, test_integer_bit_exact)
+{
+	char str[FIELD_SIZE_MAX + 1];
+	int32_t expected;
+	int32_t actual;
+	char *pos;
+
+	for (uint32_t i = 0; i < SWEEP_COUNT; i++) {
+		pos = str;
+		if (sweep_rand(4) == 0) {
+			*pos++ = '-';
+		}
+
+		pos = sweep_digits(pos, 1 + sweep_rand(9));
+		*pos = '\0';
+
+		zassert_ok(reference_atoi(str, 10, &expected));
+		zassert_ok(lx6_parse_dec_to_i32(str, INT32_MIN, INT32_MAX, &actual), "\"%s\"", str);
+		zassert_equal(actual, expected, "\"%s\"", str);
+	}
+}
+
+ZTEST(lx6_parse, test_integer_bounds)
+{
+	uint16_t u16;
+	int32_t i32;
+	uint8_t u8;
+
+	zassert_ok(lx6_parse_dec_to_u8("99", 0, 99, &u8));
+	zassert_equal(u8, 99);
+	zassert_equal(lx6_parse_dec_to_u8("100", 0, 99, &u8), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u8("256", 0, UINT8_MAX, &u8), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u8("1", 2, 99, &u8), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u8("-1", 0, 99, &u8), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u8(" 1", 0, 99, &u8), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u8("", 0, 99, &u8), -EINVAL);
+
+	zassert_ok(lx6_parse_dec_to_u16("65535", 0, UINT16_MAX, &u16));
+	zassert_equal(u16, UINT16_MAX);
+	zassert_equal(lx6_parse_dec_to_u16("65536", 0, UINT16_MAX, &u16), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_u16("99999999999", 0, UINT16_MAX, &u16), -EINVAL);
+
+	zassert_ok(lx6_parse_dec_to_i32("-2147483648", INT32_MIN, INT32_MAX, &i32));
+	zassert_equal(i32, INT32_MIN);
+	zassert_ok(lx6_parse_dec_to_i32("2147483647", INT32_MIN, INT32_MAX, &i32));
+	zassert_equal(i32, INT32_MAX);
+	zassert_equal(lx6_parse_dec_to_i32("2147483648", INT32_MIN, INT32_MAX, &i32), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_i32("-2147483649", INT32_MIN, INT32_MAX, &i32), -EINVAL);
+	zassert_equal(lx6_parse_dec_to_i32("-", INT32_MIN, INT32_MAX, &i32), -EINVAL);
+
+	zassert_ok(lx6_parse_hex_to_u8("7a", 0, UINT8_MAX, &u8));
+	zassert_equal(u8, 0x7A);
+	zassert_ok(lx6_parse_hex_to_u8("FF", 0, UINT8_MAX, &u8));
+	zassert_equal(u8, 0xFF);
+	zassert_equal(lx6_parse_hex_to_u8("100", 0, UINT8_MAX, &u8), -EINVAL);
+	zassert_equal(lx6_parse_hex_to_u8("G", 0, UINT8_MAX, &u8), -EINVAL);
+	zassert_equal(lx6_parse_hex_to_u8("", 0, UINT8_MAX, &u8), -EINVAL);
+}
+
+ZTEST_SUITE(lx6_parse, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2023 Trackunit Corporation
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include "reference.h"
+
+#define REFERENCE_NANO  (1000000000LL)
+#define REFERENCE_MICRO (1000000LL)
+#define REFERENCE_MILLI (1000LL)
+
+#define REFERENCE_PICO_DEGREES_IN_DEGREE      (1000000000000ULL)
+#define REFERENCE_PICO_DEGREES_IN_MINUTE      (REFERENCE_PICO_DEGREES_IN_DEGREE / 60ULL)
+#define REFERENCE_PICO_DEGREES_IN_NANO_DEGREE (1000ULL)
+#define REFERENCE_NANO_KNOTS_IN_MMS           (1943861LL)
+
+int reference_dec_to_nano(const char *str, int64_t *nano)
+{
+	int64_t sum = 0;
+	int8_t decimal = -1;
+	int8_t pos = 0;
+	int8_t start = 0;
+	int64_t increment;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(nano != NULL, "nano argument must be provided");
+
+	/* Find decimal */
+	while (str[pos] != '\0') {
+		/* Verify if char is decimal */
+		if (str[pos] == '.') {
+			decimal = pos;
+			break;
+		}
+
+		/* Advance position */
+		pos++;
+	}
+
+	/* Determine starting position based on decimal location */
+	pos = decimal < 0 ? pos - 1 : decimal - 1;
+
+	/* Skip sign if it exists */
+	start = str[0] == '-' ? 1 : 0;
+
+	/* Add whole value to sum */
+	increment = REFERENCE_NANO;
+	while (start <= pos) {
+		/* Verify char is decimal */
+		if (str[pos] < '0' || str[pos] > '9') {
+			return -EINVAL;
+		}
+
+		/* Add value to sum */
+		sum += (str[pos] - '0') * increment;
+
+		/* Update increment */
+		increment *= 10;
+
+		/* Degrement position */
+		pos--;
+	}
+
+	/* Check if decimal was found */
+	if (decimal < 0) {
+		/* Set sign of sum */
+		sum = start == 1 ? -sum : sum;
+
+		*nano = sum;
+		return 0;
+	}
+
+	/* Convert decimal part to nano fractions and add it to sum */
+	pos = decimal + 1;
+	increment = REFERENCE_NANO / 10LL;
+	while (str[pos] != '\0') {
+		/* Verify char is decimal */
+		if (str[pos] < '0' || str[pos] > '9') {
+			return -EINVAL;
+		}
+
+		/* Add value to micro_degrees */
+		sum += (str[pos] - '0') * increment;
+
+		/* Update unit */
+		increment /= 10;
+
+		/* Increment position */
+		pos++;
+	}
+
+	/* Set sign of sum */
+	sum = start == 1 ? -sum : sum;
+
+	*nano = sum;
+	return 0;
+}
+
+int reference_dec_to_micro(const char *str, uint64_t *micro)
+{
+	int ret;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(micro != NULL, "micro argument must be provided");
+
+	ret = reference_dec_to_nano(str, (int64_t *)micro);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*micro = (*micro) / REFERENCE_MILLI;
+	return 0;
+}
+
+int reference_dec_to_milli(const char *str, int64_t *milli)
+{
+	int ret;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(milli != NULL, "milli argument must be provided");
+
+	ret = reference_dec_to_nano(str, milli);
+	if (ret < 0) {
+		return ret;
+	}
+
+	(*milli) = (*milli) / REFERENCE_MICRO;
+	return 0;
+}
+
+int reference_atoi(const char *str, uint8_t base, int32_t *integer)
+{
+	char *end;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(integer != NULL, "integer argument must be provided");
+
+	*integer = (int32_t)strtol(str, &end, (int)base);
+
+	if ('\0' != (*end)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int reference_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg)
+{
+	uint64_t pico_degrees = 0;
+	int8_t decimal = -1;
+	int8_t pos = 0;
+	uint64_t increment;
+
+	__ASSERT(ddmm_mmmm != NULL, "ddmm_mmmm argument must be provided");
+	__ASSERT(ndeg != NULL, "ndeg argument must be provided");
+
+	/* Find decimal */
+	while (ddmm_mmmm[pos] != '\0') {
+		/* Verify if char is decimal */
+		if (ddmm_mmmm[pos] == '.') {
+			decimal = pos;
+			break;
+		}
+
+		/* Advance position */
+		pos++;
+	}
+
+	/* Verify decimal was found and placed correctly */
+	if (decimal < 1) {
+		return -EINVAL;
+	}
+
+	/* Validate potential degree fraction is within bounds */
+	if (decimal > 1 && ddmm_mmmm[decimal - 2] > '5') {
+		return -EINVAL;
+	}
+
+	/* Convert minute fraction to pico degrees and add it to pico_degrees */
+	pos = decimal + 1;
+	increment = (REFERENCE_PICO_DEGREES_IN_MINUTE / 10);
+	while (ddmm_mmmm[pos] != '\0') {
+		/* Verify char is decimal */
+		if (ddmm_mmmm[pos] < '0' || ddmm_mmmm[pos] > '9') {
+			return -EINVAL;
+		}
+
+		/* Add increment to pico_degrees */
+		pico_degrees += (ddmm_mmmm[pos] - '0') * increment;
+
+		/* Update unit */
+		increment /= 10;
+
+		/* Increment position */
+		pos++;
+	}
+
+	/* Convert minutes and degrees to pico_degrees */
+	pos = decimal - 1;
+	increment = REFERENCE_PICO_DEGREES_IN_MINUTE;
+	while (pos >= 0) {
+		/* Check if digit switched from minutes to degrees */
+		if ((decimal - pos) == 3) {
+			/* Reset increment to degrees */
+			increment = REFERENCE_PICO_DEGREES_IN_DEGREE;
+		}
+
+		/* Verify char is decimal */
+		if (ddmm_mmmm[pos] < '0' || ddmm_mmmm[pos] > '9') {
+			return -EINVAL;
+		}
+
+		/* Add increment to pico_degrees */
+		pico_degrees += (ddmm_mmmm[pos] - '0') * increment;
+
+		/* Update unit */
+		increment *= 10;
+
+		/* Decrement position */
+		pos--;
+	}
+
+	/* Convert to nano degrees */
+	*ndeg = (int64_t)(pico_degrees / REFERENCE_PICO_DEGREES_IN_NANO_DEGREE);
+	return 0;
+}
+
+int reference_knots_to_mms(const char *str, int64_t *mms)
+{
+	int ret;
+
+	__ASSERT(str != NULL, "str argument must be provided");
+	__ASSERT(mms != NULL, "mms argument must be provided");
+
+	ret = reference_dec_to_nano(str, mms);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*mms = (*mms) / REFERENCE_NANO_KNOTS_IN_MMS;
+	return 0;
+}
+
+int reference_parse_hhmmss(const char *hhmmss, struct gnss_time *utc)
+{
+	int64_t i64;
+	int32_t i32;
+	char part[3] = {0};
+
+	__ASSERT(hhmmss != NULL, "hhmmss argument must be provided");
+	__ASSERT(utc != NULL, "utc argument must be provided");
+
+	if (strlen(hhmmss) < 6) {
+		return -EINVAL;
+	}
+
+	memcpy(part, hhmmss, 2);
+	if ((reference_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 23)) {
+		return -EINVAL;
+	}
+
+	utc->hour = (uint8_t)i32;
+
+	memcpy(part, &hhmmss[2], 2);
+	if ((reference_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 59)) {
+		return -EINVAL;
+	}
+
+	utc->minute = (uint8_t)i32;
+
+	if ((reference_dec_to_milli(&hhmmss[4], &i64) < 0) || (i64 < 0) || (i64 > 59999)) {
+		return -EINVAL;
+	}
+
+	utc->millisecond = (uint16_t)i64;
+	return 0;
+}
+
+int reference_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc)
+{
+	int32_t i32;
+	char part[3] = {0};
+
+	__ASSERT(ddmmyy != NULL, "ddmmyy argument must be provided");
+	__ASSERT(utc != NULL, "utc argument must be provided");
+
+	if (strlen(ddmmyy) != 6) {
+		return -EINVAL;
+	}
+
+	memcpy(part, ddmmyy, 2);
+	if ((reference_atoi(part, 10, &i32) < 0) || (i32 < 1) || (i32 > 31)) {
+		return -EINVAL;
+	}
+
+	utc->month_day = (uint8_t)i32;
+
+	memcpy(part, &ddmmyy[2], 2);
+	if ((reference_atoi(part, 10, &i32) < 0) || (i32 < 1) || (i32 > 12)) {
+		return -EINVAL;
+	}
+
+	utc->month = (uint8_t)i32;
+
+	memcpy(part, &ddmmyy[4], 2);
+	if ((reference_atoi(part, 10, &i32) < 0) || (i32 < 0) || (i32 > 99)) {
+		return -EINVAL;
+	}
+
+	utc->century_year = (uint8_t)i32;
+	return 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Previous implementations of the parsers, which the current ones must stay
+ * bit-exact with, and which the benchmarks compare against.
+ */
+
+#ifndef REFERENCE_H_
+#define REFERENCE_H_
+
+#include <zephyr/drivers/gnss.h>
+#include <zephyr/types.h>
+
+int reference_dec_to_nano(const char *str, int64_t *nano);
+int reference_dec_to_micro(const char *str, uint64_t *micro);
+int reference_dec_to_milli(const char *str, int64_t *milli);
+int reference_atoi(const char *str, uint8_t base, int32_t *integer);
+int reference_ddmm_mmmm_to_ndeg(const char *ddmm_mmmm, int64_t *ndeg);
+int reference_knots_to_mms(const char *str, int64_t *mms);
+int reference_parse_hhmmss(const char *hhmmss, struct gnss_time *utc);
+int reference_parse_ddmmyy(const char *ddmmyy, struct gnss_time *utc);
+
+#endif /* REFERENCE_H_ */
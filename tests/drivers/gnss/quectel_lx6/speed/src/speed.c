@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 CATIE
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gnss/quectel_lx6.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/ztest.h>
+
+#include "lx6_emul.h"
+
+#define PMTK_PROBE             0
+#define PMTK_HOT_RESTART       101
+#define PMTK_FULL_COLD_RESTART 104
+#define PMTK_FIX_RATE          220
+#define PMTK_SPEED             251
+
+#define DEFAULT_SPEED DT_PROP(DT_NODELABEL(euart0), current_speed)
+#define TARGET_SPEED  DT_PROP(DT_NODELABEL(gnss), target_speed)
+
+static const struct device *gnss = DEVICE_DT_GET(DT_NODELABEL(gnss));
+static const struct device *uart = DEVICE_DT_GET(DT_NODELABEL(euart0));
+
+static uint32_t uart_speed(void)
+{
+	struct uart_config uart_config;
+
+	zassert_ok(uart_config_get(uart, &uart_config));
+	return uart_config.baudrate;
+}
+
+/* Check the receiver and the UART run at speed, and that the receiver can be configured */
+static void assert_speed(uint32_t speed)
+{
+	struct quectel_lx6_profile profile;
+
+	zassert_equal(lx6_emul_get_speed(), speed);
+	zassert_equal(uart_speed(), speed);
+
+	/* Another fix rate than the applied one is sent */
+	zassert_ok(quectel_lx6_get_profile(gnss, &profile));
+	profile.settings = QUECTEL_LX6_PROFILE_FIX_RATE;
+	profile.fix_interval_ms = (profile.fix_interval_ms == 1000) ? 500 : 1000;
+
+	lx6_emul_reset();
+	zassert_ok(quectel_lx6_apply_profile(gnss, &profile));
+	zassert_equal(lx6_emul_count(), 1);
+	zassert_equal(lx6_emul_command_id(0), PMTK_FIX_RATE);
+}
+
+/* Index of the first command recorded from index on, -1 if none */
+static int find_command(uint16_t command, size_t index)
+{
+	for (size_t i = index; i < lx6_emul_count(); i++) {
+		if (lx6_emul_command_id(i) == command) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+static int speed_command(void)
+{
+	return find_command(PMTK_SPEED, 0);
+}
+
+/* Power cycle the receiver, which reverts to its default speed */
+static void power_cycle(void)
+{
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_TURN_OFF));
+	lx6_emul_set_speed(DEFAULT_SPEED);
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_TURN_ON));
+	lx6_emul_reset();
+}
+
+static void *setup(void)
+{
+	lx6_emul_init(uart);
+	zassert_ok(device_init(gnss));
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Receiver is switched to the target speed again if a test left it elsewhere */
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	zassert_equal(uart_speed(), TARGET_SPEED);
+	lx6_emul_reset();
+}
+
+ZTEST(lx6_driver_speed, test_switched_at_init)
+{
+	assert_speed(TARGET_SPEED);
+}
+
+ZTEST(lx6_driver_speed, test_switched_once_power_cycled)
+{
+	power_cycle();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+
+	zassert_true(speed_command() >= 0);
+	zassert_str_equal(lx6_emul_command(speed_command()), "PMTK251,115200");
+	assert_speed(TARGET_SPEED);
+
+	/* Nothing to switch once at the target speed */
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	zassert_equal(speed_command(), -1);
+}
+
+ZTEST(lx6_driver_speed, test_fallback_on_resume)
+{
+	power_cycle();
+
+	/* Receiver ignores the switch, so it is still used at its default speed */
+	lx6_emul_fail(PMTK_SPEED);
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	zassert_true(speed_command() >= 0);
+	assert_speed(DEFAULT_SPEED);
+
+	/* Switch is attempted again on the next resume */
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_SUSPEND));
+	lx6_emul_reset();
+	zassert_ok(pm_device_action_run(gnss, PM_DEVICE_ACTION_RESUME));
+	zassert_true(speed_command() >= 0);
+	assert_speed(TARGET_SPEED);
+}
+
+ZTEST(lx6_driver_speed, test_fallback_reported)
+{
+	/* A full cold restart needs the receiver back at its default speed first */
+	lx6_emul_fail(PMTK_SPEED);
+	zassert_equal(quectel_lx6_restart(gnss, QUECTEL_LX6_RESTART_FULL_COLD), -EIO);
+	zassert_true(speed_command() >= 0);
+	assert_speed(TARGET_SPEED);
+}
+
+ZTEST(lx6_driver_speed, test_full_cold_restart)
+{
+	int restart;
+
+	/* Receiver is back at its default speed to report its startup, then switched again */
+	zassert_ok(quectel_lx6_restart(gnss, QUECTEL_LX6_RESTART_FULL_COLD));
+	zassert_str_equal(lx6_emul_command(speed_command()), "PMTK251,9600");
+
+	restart = find_command(PMTK_FULL_COLD_RESTART, 0);
+	zassert_true(restart > speed_command());
+	zassert_true(find_command(PMTK_SPEED, restart) > restart);
+	zassert_str_equal(lx6_emul_command(find_command(PMTK_SPEED, restart)), "PMTK251,115200");
+	assert_speed(TARGET_SPEED);
+}
+
+ZTEST(lx6_driver_speed, test_restart_probes_speed)
+{
+	int restart;
+
+	/* Speed is kept, but still probed once restarted */
+	zassert_ok(quectel_lx6_restart(gnss, QUECTEL_LX6_RESTART_HOT));
+	zassert_equal(speed_command(), -1);
+
+	restart = find_command(PMTK_HOT_RESTART, 0);
+	zassert_true(restart >= 0);
+	zassert_true(find_command(PMTK_PROBE, restart) > restart);
+	assert_speed(TARGET_SPEED);
+}
+
+ZTEST_SUITE(lx6_driver_speed, NULL, setup, before, NULL, NULL);